@@ -1,7 +1,282 @@
 #include "binary.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <zlib.h>
+#if defined(PETSC_WRAPPER_HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
 namespace Petsc {
 
+#ifdef PETSC_HAVE_MPIIO
+namespace {
+
+/// @brief Container header: magic, version, codec, size, scalar size, chunk size, chunks, reserved
+constexpr Int64 containerMagic = 0x50575A43;
+constexpr Int64 containerVersion = 1;
+constexpr MPI_Offset headerBytes = 8 * sizeof(Int64);
+
+/// @brief Chunk index entry: global start, number of entries, offset in the data section, bytes
+constexpr MPI_Offset entryBytes = 4 * sizeof(Int64);
+
+/// @brief Converts between the big-endian order of the file and the native one
+void SwapBigEndian(void* data, PetscDataType type, Int count) {
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  PetscCallThrow(PetscByteSwap(data, type, count));
+#endif
+}
+
+bool IsSupported(Binary::Codec codec) {
+#if defined(PETSC_WRAPPER_HAVE_ZSTD)
+  return codec == Binary::Zlib || codec == Binary::Zstd;
+#else
+  return codec == Binary::Zlib;
+#endif
+}
+
+bool Compress(Binary::Codec codec, const char* data, std::size_t size, std::vector<unsigned char>& out) {
+#if defined(PETSC_WRAPPER_HAVE_ZSTD)
+  if (codec == Binary::Zstd) {
+    out.resize(ZSTD_compressBound(size));
+    std::size_t bytes = ZSTD_compress(out.data(), out.size(), data, size, 1);
+    out.resize(ZSTD_isError(bytes) ? 0 : bytes);
+    return !ZSTD_isError(bytes);
+  }
+#endif
+  uLongf bytes = compressBound(size);
+  out.resize(bytes);
+  int status = compress2(out.data(), &bytes, reinterpret_cast<const Bytef*>(data), size, Z_BEST_SPEED);
+  out.resize(bytes);
+  return status == Z_OK;
+}
+
+/// @brief Decompresses into at most `capacity` bytes, returns the size or -1 on failure
+Int64 Decompress(Binary::Codec codec, const unsigned char* data, std::size_t size, char* out, std::size_t capacity) {
+#if defined(PETSC_WRAPPER_HAVE_ZSTD)
+  if (codec == Binary::Zstd) {
+    std::size_t bytes = ZSTD_decompress(out, capacity, data, size);
+    return ZSTD_isError(bytes) ? -1 : (Int64)bytes;
+  }
+#endif
+  uLongf bytes = capacity;
+  int status = uncompress(reinterpret_cast<Bytef*>(out), &bytes, data, size);
+  return status == Z_OK ? (Int64)bytes : -1;
+}
+
+/// @brief Byte swap of `count` values of `width` bytes to or from big-endian, safe in OpenMP threads
+void SwapBytes(char* data, std::size_t width, Int64 count) {
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  for (Int64 i = 0; i < count; ++i) {
+    std::reverse(data + i * width, data + (i + 1) * width);
+  }
+#endif
+}
+
+/// @brief Lossy chunk payload: mode, minimum, then the deltas of the quantized values or the values
+constexpr Int64 quantizedChunk = 0;
+constexpr Int64 verbatimChunk = 1;
+constexpr std::size_t payloadHeaderBytes = sizeof(Int64) + sizeof(Real);
+constexpr Int realsPerScalar = sizeof(Scalar) / sizeof(Real);
+
+/// @brief Quantizes `n` reals to multiples of `step` above the chunk minimum, and stores the
+/// differences of consecutive integers, which are small and compress well for smooth fields.
+/// Chunks with non-finite values or too wide range are kept verbatim.
+/// @returns Big-endian payload and the maximum error of the reconstruction
+Real Quantize(const Real* x, Int64 n, Real step, std::vector<char>& payload) {
+  Real lo = PETSC_MAX_REAL;
+  Real hi = PETSC_MIN_REAL;
+  int finite = 1;
+  #pragma omp simd reduction(min:lo) reduction(max:hi) reduction(&:finite)
+  for (Int64 i = 0; i < n; ++i) {
+    lo = std::min(lo, x[i]);
+    hi = std::max(hi, x[i]);
+    finite &= (int)std::isfinite(x[i]);
+  }
+
+  Int64 mode = finite && n > 0 && (hi - lo) / step < (Real)std::numeric_limits<int32_t>::max() ? quantizedChunk : verbatimChunk;
+  std::size_t width = mode == quantizedChunk ? sizeof(int32_t) : sizeof(Real);
+  payload.resize(payloadHeaderBytes + n * width);
+  char* body = payload.data() + payloadHeaderBytes;
+  Real error = 0;
+
+  if (mode == quantizedChunk) {
+    std::vector<int32_t> q(n);
+    #pragma omp simd reduction(max:error)
+    for (Int64 i = 0; i < n; ++i) {
+      Real level = std::nearbyint((x[i] - lo) / step);
+      q[i] = (int32_t)level;
+      error = std::max(error, std::abs(lo + level * step - x[i]));
+    }
+    auto* deltas = reinterpret_cast<int32_t*>(body);
+    #pragma omp simd
+    for (Int64 i = 1; i < n; ++i) {
+      deltas[i] = q[i] - q[i - 1];
+    }
+    deltas[0] = q[0];
+  } else {
+    lo = 0;
+    std::copy(x, x + n, reinterpret_cast<Real*>(body));
+  }
+
+  std::copy_n(reinterpret_cast<const char*>(&mode), sizeof(Int64), payload.data());
+  std::copy_n(reinterpret_cast<const char*>(&lo), sizeof(Real), payload.data() + sizeof(Int64));
+  SwapBytes(payload.data(), sizeof(Int64), 1);
+  SwapBytes(payload.data() + sizeof(Int64), sizeof(Real), 1);
+  SwapBytes(body, width, n);
+  return error;
+}
+
+/// @brief Reconstructs `n` reals from a big-endian payload of `Quantize()`, swaps it in place
+bool Dequantize(char* payload, Int64 bytes, Int64 n, Real step, Real* x) {
+  if (bytes < (Int64)payloadHeaderBytes) {
+    return false;
+  }
+  SwapBytes(payload, sizeof(Int64), 1);
+  SwapBytes(payload + sizeof(Int64), sizeof(Real), 1);
+  Int64 mode;
+  Real lo;
+  std::copy_n(payload, sizeof(Int64), reinterpret_cast<char*>(&mode));
+  std::copy_n(payload + sizeof(Int64), sizeof(Real), reinterpret_cast<char*>(&lo));
+
+  char* body = payload + payloadHeaderBytes;
+  if (mode == quantizedChunk && bytes == (Int64)(payloadHeaderBytes + n * sizeof(int32_t))) {
+    SwapBytes(body, sizeof(int32_t), n);
+    const auto* deltas = reinterpret_cast<const int32_t*>(body);
+    Int64 level = 0;
+    for (Int64 i = 0; i < n; ++i) {
+      level += deltas[i];
+      x[i] = lo + (Real)level * step;
+    }
+    return true;
+  }
+  if (mode == verbatimChunk && bytes == (Int64)(payloadHeaderBytes + n * sizeof(Real))) {
+    SwapBytes(body, sizeof(Real), n);
+    std::copy_n(reinterpret_cast<const Real*>(body), n, x);
+    return true;
+  }
+  return false;
+}
+
+/// @brief Collective transfer of `bytes` at `offset`, split into pieces that fit into `int` counts
+template<typename Transfer>
+void TransferAll(MPI_Comm comm, MPI_Offset offset, char* data, Int64 bytes, Transfer&& transfer) {
+  constexpr Int64 piece = 1 << 30;
+  Int64 pieces = (bytes + piece - 1) / piece;
+  PetscCallMPIThrow(MPI_Allreduce(MPI_IN_PLACE, &pieces, 1, MPI_INT64_T, MPI_MAX, comm));
+
+  for (Int64 p = 0; p < pieces; ++p) {
+    Int64 begin = std::min(bytes, p * piece);
+    Int64 size = std::min(bytes - begin, piece);
+    PetscCallMPIThrow(transfer(offset + begin, data + begin, (int)size));
+  }
+}
+
+/// @brief Writes the container of `WriteCompressed()`, values are quantized with `step` if positive
+/// @returns Maximum error of the quantization over all processes
+Real WriteContainer(Binary& viewer, const Vec& vec, Int chunkSize, Binary::Codec codec, Real step) {
+  if (chunkSize <= 0 || !IsSupported(codec)) {
+    PetscCallThrow(PETSC_ERR_SUP);
+  }
+
+  MPI_Comm comm = PetscObjectComm(viewer);
+  MPI_File fd = viewer.GetMPIIODescriptor();
+  MPI_Offset base = viewer.GetMPIIOOffset();
+  PetscCallMPIThrow(MPI_File_set_view(fd, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL));
+
+  MPIInt rank;
+  PetscCallMPIThrow(MPI_Comm_rank(comm, &rank));
+
+  Int size = vec.GetSize();
+  auto [start, end] = vec.GetOwnershipRange();
+  Int local = end - start;
+
+  std::vector<Scalar> values(local);
+  {
+    auto array = vec.GetArrayRead();
+    std::copy((const Scalar*)array, (const Scalar*)array + local, values.data());
+  }
+  if (step <= 0) {
+    SwapBigEndian(values.data(), PETSC_SCALAR, local);
+  }
+
+  Int chunks = (local + chunkSize - 1) / chunkSize;
+  std::vector<std::vector<unsigned char>> compressed(chunks);
+  std::vector<int> failed(chunks, 0);
+  Real error = 0;
+
+  #pragma omp parallel for schedule(dynamic) reduction(max:error)
+  for (Int c = 0; c < chunks; ++c) {
+    Int count = std::min(chunkSize, local - c * chunkSize);
+    if (step > 0) {
+      std::vector<char> payload;
+      const Real* reals = reinterpret_cast<const Real*>(values.data() + c * chunkSize);
+      error = std::max(error, Quantize(reals, count * realsPerScalar, step, payload));
+      failed[c] = !Compress(codec, payload.data(), payload.size(), compressed[c]);
+    } else {
+      const char* data = reinterpret_cast<const char*>(values.data() + c * chunkSize);
+      failed[c] = !Compress(codec, data, count * sizeof(Scalar), compressed[c]);
+    }
+  }
+  if (std::any_of(failed.begin(), failed.end(), [](int f) { return f; })) {
+    PetscCallThrow(PETSC_ERR_LIB);
+  }
+  PetscCallMPIThrow(MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPIU_REAL, MPI_MAX, comm));
+
+  Int64 counts[2] = {chunks, 0};
+  for (const auto& chunk : compressed) {
+    counts[1] += (Int64)chunk.size();
+  }
+
+  // Positions of the first chunk of the process in the index and in the data section
+  Int64 firsts[2] = {0, 0};
+  Int64 totals[2];
+  PetscCallMPIThrow(MPI_Exscan(counts, firsts, 2, MPI_INT64_T, MPI_SUM, comm));
+  PetscCallMPIThrow(MPI_Allreduce(counts, totals, 2, MPI_INT64_T, MPI_SUM, comm));
+  if (rank == 0) {
+    firsts[0] = firsts[1] = 0;
+  }
+
+  std::vector<Int64> index(4 * chunks);
+  std::vector<char> data(counts[1]);
+  Int64 offset = 0;
+  for (Int c = 0; c < chunks; ++c) {
+    index[4 * c + 0] = start + c * chunkSize;
+    index[4 * c + 1] = std::min(chunkSize, local - c * chunkSize);
+    index[4 * c + 2] = firsts[1] + offset;
+    index[4 * c + 3] = (Int64)compressed[c].size();
+    std::copy(compressed[c].begin(), compressed[c].end(), data.begin() + offset);
+    offset += (Int64)compressed[c].size();
+  }
+  SwapBigEndian(index.data(), PETSC_INT64, 4 * chunks);
+
+  // The quantization step is stored as the bits of a double, zero for lossless containers
+  double quantization = step > 0 ? (double)step : 0.0;
+  Int64 header[8] = {containerMagic, containerVersion, codec, size, (Int64)sizeof(Scalar), chunkSize, totals[0], 0};
+  std::copy_n(reinterpret_cast<const char*>(&quantization), sizeof(Int64), reinterpret_cast<char*>(&header[7]));
+  SwapBigEndian(header, PETSC_INT64, 8);
+
+  auto write = [&](MPI_Offset at, char* buffer, int bytes) {
+    return MPI_File_write_at_all(fd, at, buffer, bytes, MPI_BYTE, MPI_STATUS_IGNORE);
+  };
+  MPI_Offset indexBase = base + headerBytes;
+  MPI_Offset dataBase = indexBase + totals[0] * entryBytes;
+
+  TransferAll(comm, base, reinterpret_cast<char*>(header), rank == 0 ? headerBytes : 0, write);
+  TransferAll(comm, indexBase + firsts[0] * entryBytes, reinterpret_cast<char*>(index.data()), chunks * entryBytes, write);
+  TransferAll(comm, dataBase + firsts[1], data.data(), counts[1], write);
+
+  viewer.AddMPIIOOffset(headerBytes + totals[0] * entryBytes + totals[1]);
+  return error;
+}
+
+}
+#endif
+
 Binary::Binary(MPI_Comm comm, std::string_view name, FileMode mode)
     : Viewer(name) {
   PetscCallThrow(PetscViewerBinaryOpen(comm, name.data(), mode, &that));
@@ -17,8 +292,8 @@ void Binary::Write(int fd, const void *data, Int size, DataType type) {
   PetscCallThrow(PetscBinaryWrite(fd, data, size, type));
 }
 
-void Binary::Read(int fd, const void *data, Int size, DataType type) {
-  PetscCallThrow(PetscBinaryWrite(fd, data, size, type));
+void Binary::Read(int fd, void *data, Int size, DataType type) {
+  PetscCallThrow(PetscBinaryRead(fd, data, size, NULL, type));
 }
 
 Int Binary::GetFlowControl() {
@@ -57,6 +332,141 @@ MPI_Offset Binary::GetMPIIOOffset() {
 void Binary::AddMPIIOOffset(MPI_Offset off) {
   PetscCallThrow(PetscViewerBinaryAddMPIIOOffset(that, off));
 }
+
+void Binary::WriteCompressed(const Vec& vec, Int chunkSize, Codec codec) {
+  WriteContainer(*this, vec, chunkSize, codec, 0);
+}
+
+Real Binary::WriteQuantized(const Vec& vec, Real bound, Bool relative, Int chunkSize, Codec codec) {
+  if (bound <= 0) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+
+  Real absolute = bound;
+  if (relative) {
+    // The relative bound is scaled by the range of the finite values, real and imaginary parts together,
+    // chunks with non-finite values are stored verbatim anyway
+    Real range[2] = {PETSC_MIN_REAL, PETSC_MIN_REAL};
+    {
+      auto array = vec.GetArrayRead();
+      const Real* reals = reinterpret_cast<const Real*>((const Scalar*)array);
+      Int n = vec.GetLocalSize() * realsPerScalar;
+      Real lo = PETSC_MAX_REAL;
+      Real hi = PETSC_MIN_REAL;
+      #pragma omp parallel for simd reduction(min:lo) reduction(max:hi)
+      for (Int i = 0; i < n; ++i) {
+        if (std::isfinite(reals[i])) {
+          lo = std::min(lo, reals[i]);
+          hi = std::max(hi, reals[i]);
+        }
+      }
+      range[0] = -lo;
+      range[1] = hi;
+    }
+    PetscCallMPIThrow(MPI_Allreduce(MPI_IN_PLACE, range, 2, MPIU_REAL, MPI_MAX, PetscObjectComm(*this)));
+    absolute = bound * (range[1] + range[0]);
+  }
+  // A constant or non-finite vector has no range to scale the bound with
+  if (!std::isfinite(absolute) || absolute <= 0) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+
+  // Slightly below twice the bound, so the rounding of the reconstruction stays within it
+  Real step = (Real)1.99 * absolute;
+  return WriteContainer(*this, vec, chunkSize, codec, step);
+}
+
+Real Binary::GetMaxError(const Vec& reference, const Vec& vec) {
+  return Vec::WAXPY(-1.0, reference, vec).Norm(NORM_INFINITY);
+}
+
+void Binary::ReadCompressed(Vec& vec) {
+  MPI_Comm comm = PetscObjectComm(*this);
+  MPI_File fd = GetMPIIODescriptor();
+  MPI_Offset base = GetMPIIOOffset();
+  PetscCallMPIThrow(MPI_File_set_view(fd, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL));
+
+  auto read = [&](MPI_Offset at, char* buffer, int bytes) {
+    return MPI_File_read_at_all(fd, at, buffer, bytes, MPI_BYTE, MPI_STATUS_IGNORE);
+  };
+
+  Int64 header[8];
+  TransferAll(comm, base, reinterpret_cast<char*>(header), headerBytes, read);
+  SwapBigEndian(header, PETSC_INT64, 8);
+
+  auto codec = (Codec)header[2];
+  if (header[0] != containerMagic || header[1] != containerVersion || header[4] != (Int64)sizeof(Scalar)) {
+    PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+  }
+  if (header[3] != vec.GetSize()) {
+    PetscCallThrow(PETSC_ERR_ARG_SIZ);
+  }
+  if (!IsSupported(codec)) {
+    PetscCallThrow(PETSC_ERR_SUP);
+  }
+
+  double quantization;
+  std::copy_n(reinterpret_cast<const char*>(&header[7]), sizeof(Int64), reinterpret_cast<char*>(&quantization));
+  auto step = (Real)quantization;
+
+  Int64 chunks = header[6];
+  std::vector<Int64> index(4 * chunks);
+  MPI_Offset dataBase = base + headerBytes + chunks * entryBytes;
+  TransferAll(comm, base + headerBytes, reinterpret_cast<char*>(index.data()), chunks * entryBytes, read);
+  SwapBigEndian(index.data(), PETSC_INT64, 4 * chunks);
+
+  // Chunks are ordered by their global start, only the ones overlapping the local range are read
+  auto [start, end] = vec.GetOwnershipRange();
+  Int64 first = 0;
+  while (first < chunks && index[4 * first] + index[4 * first + 1] <= start) {
+    ++first;
+  }
+  Int64 last = first;
+  while (last < chunks && index[4 * last] < end) {
+    ++last;
+  }
+
+  Int64 spanBegin = first < last ? index[4 * first + 2] : 0;
+  Int64 spanEnd = first < last ? index[4 * (last - 1) + 2] + index[4 * (last - 1) + 3] : 0;
+  std::vector<unsigned char> data(spanEnd - spanBegin);
+  TransferAll(comm, dataBase + spanBegin, reinterpret_cast<char*>(data.data()), spanEnd - spanBegin, read);
+
+  std::vector<int> failed(last - first, 0);
+  {
+    auto array = vec.GetArray(Write);
+    Scalar* values = array;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (Int64 c = first; c < last; ++c) {
+      Int64 chunkStart = index[4 * c];
+      Int64 count = index[4 * c + 1];
+      const unsigned char* source = data.data() + index[4 * c + 2] - spanBegin;
+      std::vector<Scalar> chunk(count);
+      if (step > 0) {
+        std::vector<char> payload(payloadHeaderBytes + count * realsPerScalar * std::max(sizeof(int32_t), sizeof(Real)));
+        Int64 bytes = Decompress(codec, source, index[4 * c + 3], payload.data(), payload.size());
+        failed[c - first] = bytes < 0 ||
+          !Dequantize(payload.data(), bytes, count * realsPerScalar, step, reinterpret_cast<Real*>(chunk.data()));
+      } else {
+        Int64 bytes = Decompress(codec, source, index[4 * c + 3], reinterpret_cast<char*>(chunk.data()), count * sizeof(Scalar));
+        failed[c - first] = bytes != (Int64)(count * sizeof(Scalar));
+      }
+
+      Int64 from = std::max<Int64>(chunkStart, start);
+      Int64 to = std::min<Int64>(chunkStart + count, end);
+      std::copy(chunk.data() + (from - chunkStart), chunk.data() + (to - chunkStart), values + (from - start));
+    }
+    if (step <= 0) {
+      SwapBigEndian(values, PETSC_SCALAR, end - start);
+    }
+  }
+  if (std::any_of(failed.begin(), failed.end(), [](int f) { return f; })) {
+    PetscCallThrow(PETSC_ERR_FILE_READ);
+  }
+
+  Int64 total = chunks > 0 ? index[4 * (chunks - 1) + 2] + index[4 * (chunks - 1) + 3] : 0;
+  AddMPIIOOffset(headerBytes + chunks * entryBytes + total);
+}
 #endif
 
 int Binary::GetDescriptor() const {
@@ -7,11 +7,10 @@
 
 #include "exception.h"
 #include "utils.h"
+#include "vec.h"
 
 namespace Petsc {
 
-/// @todo binary file compression with .gz postfix
-
 using DataType = PetscDataType;
 
 class Binary : public Viewer {
@@ -25,7 +24,7 @@ class Binary : public Viewer {
   static Binary Open(MPI_Comm comm, std::string_view name, FileMode mode);
 
   static void Write(int fd, const void *data, Int size, DataType type);
-  static void Read(int fd, const void *data, Int size, DataType type);
+  static void Read(int fd, void *data, Int size, DataType type);
 
   void SetFlowControl(Int fc);
   Int GetFlowControl();
@@ -36,6 +35,30 @@ class Binary : public Viewer {
   MPI_File GetMPIIODescriptor();
   MPI_Offset GetMPIIOOffset();
   void AddMPIIOOffset(MPI_Offset off);
+
+  /// @brief Compression libraries of the chunked container, zstd is available if found at build
+  enum Codec {
+    Zlib = 1,
+    Zstd,
+  };
+
+  /// @brief Writes the vector as a compressed container at the current MPI-IO offset. Each process
+  /// compresses its part in chunks of `chunkSize` entries with OpenMP threads, and the container
+  /// records the global range and the position of each chunk, so that any partition can read it.
+  void WriteCompressed(const Vec& vec, Int chunkSize = 1 << 16, Codec codec = Zlib);
+  /// @brief Lossy variant of `WriteCompressed()` for visualization output. Values are quantized so that
+  /// the error is at most `bound`, or `bound` times the range of the values if `relative`, and chunks
+  /// store the differences of the quantized values.
+  /// @returns Maximum error achieved over the vector
+  /// @note The range only covers the finite values, and a bound that is not positive and finite after the
+  /// scaling, as for a constant vector, is an error
+  Real WriteQuantized(const Vec& vec, Real bound, Bool relative = PETSC_FALSE, Int chunkSize = 1 << 16, Codec codec = Zlib);
+  /// @brief Reads and decompresses only the chunks that overlap the ownership range of `vec`,
+  /// quantized containers are reconstructed directly into it
+  void ReadCompressed(Vec& vec);
+
+  /// @brief Maximum absolute difference, to verify the error of a quantized container read back
+  static Real GetMaxError(const Vec& reference, const Vec& vec);
 #endif
 
   int GetDescriptor() const;
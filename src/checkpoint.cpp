@@ -0,0 +1,213 @@
+#include "checkpoint.h"
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Petsc {
+
+AsyncCheckpointWriter::AsyncCheckpointWriter(MPI_Comm comm, std::string_view filename, std::size_t bufferSize) {
+  if (bufferSize < 2 * sizeof(Scalar)) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+  PetscCallMPIThrow(MPI_Comm_dup(comm, &this->comm));
+  PetscCallMPIThrow(MPI_Comm_rank(this->comm, &rank));
+
+  // The file is truncated by the first process before the others open it
+  std::string name(filename);
+  int opened = 1;
+  if (rank == 0) {
+    fd = open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    opened = fd >= 0;
+  }
+  PetscCallMPIThrow(MPI_Bcast(&opened, 1, MPI_INT, 0, this->comm));
+  if (rank != 0 && opened) {
+    fd = open(name.c_str(), O_WRONLY);
+  }
+  if (fd < 0) {
+    MPI_Comm_free(&this->comm);
+    PetscCallThrow(PETSC_ERR_FILE_OPEN);
+  }
+
+  for (auto& buffer : buffers) {
+    buffer.data.resize(bufferSize);
+  }
+  thread = std::thread(&AsyncCheckpointWriter::Run, this);
+}
+
+void AsyncCheckpointWriter::Write(const Vec& vec) {
+  Int size = vec.GetSize();
+  auto [start, end] = vec.GetOwnershipRange();
+  off_t header = 2 * sizeof(Int);
+
+  if (rank == 0) {
+    Int info[2] = {VEC_FILE_CLASSID, size};
+    Stage(cursor, info, 2, sizeof(Int), PETSC_INT);
+  }
+
+  auto array = vec.GetArrayRead();
+  Stage(cursor + header + start * sizeof(Scalar), (const Scalar*)array, end - start, sizeof(Scalar), PETSC_SCALAR);
+
+  cursor += header + size * sizeof(Scalar);
+}
+
+void AsyncCheckpointWriter::Write(const DA& da, const Vec& global) {
+  auto natural = da.CreateNaturalVector();
+  da.GlobalToNatural(global, INSERT_VALUES, natural);
+  Write(natural);
+}
+
+void AsyncCheckpointWriter::Stage(off_t offset, const void* data, Int count, std::size_t width, PetscDataType type) {
+  const char* bytes = static_cast<const char*>(data);
+  while (count > 0) {
+    Buffer& buffer = buffers[current];
+    Int fit = (Int)((buffer.data.size() - buffer.used) / width);
+    if (fit == 0) {
+      Submit();
+      continue;
+    }
+
+    Int n = std::min(count, fit);
+    std::size_t size = n * width;
+    char* staged = buffer.data.data() + buffer.used;
+    std::memcpy(staged, bytes, size);
+
+    // PETSc binary files are big-endian
+#if !defined(PETSC_WORDS_BIGENDIAN)
+    PetscCallThrow(PetscByteSwap(staged, type, n));
+#endif
+
+    buffer.segments.emplace_back(Segment{offset, buffer.used, size});
+    buffer.used += size;
+    offset += size;
+    bytes += size;
+    count -= n;
+  }
+}
+
+void AsyncCheckpointWriter::Submit(bool check) {
+  if (buffers[current].used > 0) {
+    {
+      std::lock_guard lock(mutex);
+      buffers[current].busy = true;
+      queue.emplace_back(current);
+    }
+    condition.notify_all();
+    current = 1 - current;
+  }
+
+  // Back-pressure, the next buffer is reused only after it is written
+  std::unique_lock lock(mutex);
+  condition.wait(lock, [&]() { return !buffers[current].busy; });
+  if (check && error) {
+    PetscCallThrow(PETSC_ERR_FILE_WRITE);
+  }
+}
+
+void AsyncCheckpointWriter::Flush() {
+  Submit();
+}
+
+void AsyncCheckpointWriter::Wait() {
+  // Errors are checked together, so that all processes reach the reduction
+  Submit(false);
+  int failed;
+  {
+    std::unique_lock lock(mutex);
+    condition.wait(lock, [&]() { return !buffers[0].busy && !buffers[1].busy; });
+    failed = error != 0;
+  }
+
+  PetscCallMPIThrow(MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_LOR, comm));
+  if (failed) {
+    PetscCallThrow(PETSC_ERR_FILE_WRITE);
+  }
+}
+
+void AsyncCheckpointWriter::Run() {
+  for (;;) {
+    Int index;
+    {
+      std::unique_lock lock(mutex);
+      condition.wait(lock, [&]() { return stop || !queue.empty(); });
+      if (queue.empty()) {
+        return;
+      }
+      index = queue.front();
+      queue.pop_front();
+    }
+
+    Buffer& buffer = buffers[index];
+    int status = 0;
+    for (const auto& segment : buffer.segments) {
+      const char* data = buffer.data.data() + segment.begin;
+      std::size_t written = 0;
+      while (written < segment.size && status == 0) {
+        ssize_t result = pwrite(fd, data + written, segment.size - written, segment.offset + written);
+        if (result > 0) {
+          written += result;
+        }
+        else if (result == 0) {
+          status = EIO;
+        }
+        else if (errno != EINTR) {
+          status = errno;
+        }
+      }
+    }
+
+    {
+      std::lock_guard lock(mutex);
+      if (status) {
+        error = status;
+      }
+      buffer.used = 0;
+      buffer.segments.clear();
+      buffer.busy = false;
+    }
+    condition.notify_all();
+  }
+}
+
+void AsyncCheckpointWriter::Close() {
+  if (!thread.joinable()) {
+    return;
+  }
+
+  // The thread is stopped and the file closed even if the snapshots failed
+  std::exception_ptr failure;
+  try {
+    Wait();
+  }
+  catch (...) {
+    failure = std::current_exception();
+  }
+
+  {
+    std::lock_guard lock(mutex);
+    stop = true;
+  }
+  condition.notify_all();
+  thread.join();
+
+  int closed = close(fd);
+  fd = -1;
+  int freed = MPI_Comm_free(&comm);
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+  if (closed != 0) {
+    PetscCallThrow(PETSC_ERR_FILE_WRITE);
+  }
+  PetscCallMPIThrow(freed);
+}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter() noexcept(false) {
+  Close();
+}
+
+}
@@ -0,0 +1,87 @@
+#ifndef SRC_CHECKPOINT_H
+#define SRC_CHECKPOINT_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <petscsys.h>
+
+#include "exception.h"
+#include "utils.h"
+#include "vec.h"
+#include "dmda.h"
+
+namespace Petsc {
+
+/// @brief Writes vectors in PETSc binary format in the background. Vectors are byte-swapped into
+/// one of two staging buffers of the process and written by a dedicated thread with `pwrite()`,
+/// so the caller blocks only when both buffers are still being written. The file can be loaded by
+/// `Vec::Load()` with the `.info` file skipped.
+class AsyncCheckpointWriter {
+ public:
+  /// @param bufferSize Size of each of the two staging buffers of the process in bytes
+  AsyncCheckpointWriter(MPI_Comm comm, std::string_view filename, std::size_t bufferSize = 64 << 20);
+  PETSC_NO_COPY_POLICY(AsyncCheckpointWriter);
+
+  /// @brief Appends a snapshot of `vec` to the file, collective
+  void Write(const Vec& vec);
+  /// @brief Appends a snapshot of the DA vector in the natural ordering, as `Vec::View()` does
+  void Write(const DA& da, const Vec& global);
+
+  /// @brief Hands the partially filled staging buffer to the I/O thread
+  void Flush();
+  /// @brief Flushes and waits until all snapshots of all processes are written, collective
+  void Wait();
+
+  void Close();
+  ~AsyncCheckpointWriter() noexcept(false);
+
+ private:
+  /// @brief Copies `count` elements of `type` into the staging buffers to be written at `offset`
+  void Stage(off_t offset, const void* data, Int count, std::size_t width, PetscDataType type);
+  /// @brief Hands the current buffer to the I/O thread and waits for the other one
+  /// @param check Throws on the write errors of the thread
+  void Submit(bool check = true);
+  void Run();
+
+  struct Segment {
+    off_t offset;
+    std::size_t begin;
+    std::size_t size;
+  };
+
+  struct Buffer {
+    std::vector<char> data;
+    std::size_t used = 0;
+    std::vector<Segment> segments;
+    bool busy = false;
+  };
+
+  MPI_Comm comm = MPI_COMM_NULL;
+  MPIInt rank;
+  int fd = -1;
+
+  /// @brief End of the file, the same on all processes
+  off_t cursor = 0;
+
+  Buffer buffers[2];
+  Int current = 0;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<Int> queue;
+  bool stop = false;
+  int error = 0;
+
+  std::thread thread;
+};
+
+}
+
+#endif // SRC_CHECKPOINT_H
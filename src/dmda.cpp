@@ -1,38 +1,420 @@
 #include "dmda.h"
 
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include "scatter.h"
+
 namespace Petsc {
 
-DA::DA(std::string_view name) : DM(name) {
-  PetscCallThrow(DMDACreate(PETSC_COMM_WORLD, &that));
+namespace {
+
+void ShrinkToInterior(Int& start, Int& size, Int global, Int s, DM::BoundaryType boundary) {
+  if (boundary == DM_BOUNDARY_PERIODIC) {
+    return;
+  }
+  Int lo = std::max(start, s);
+  Int hi = std::min(start + size, global - s);
+  start = lo;
+  size = std::max<Int>(0, hi - lo);
+}
+
+void ShrinkFromGhosts(Int& start, Int& size, Int ghostStart, Int ghostSize, Int s) {
+  Int lo = start + (ghostStart < start ? s : 0);
+  Int hi = start + size - (ghostStart + ghostSize > start + size ? s : 0);
+  start = lo;
+  size = std::max<Int>(0, hi - lo);
+}
+
+/// @brief Reference to the PETSc inner communicator of a user one. Objects created on the user
+/// communicator live on the inner one and keep it alive, unlike the user handle it is not reused
+/// while they exist.
+class InnerComm {
+ public:
+  InnerComm(MPI_Comm comm) { PetscCallThrow(PetscCommDuplicate(comm, &inner, NULL)); }
+  ~InnerComm() noexcept(false) { PetscCallThrow(PetscCommDestroy(&inner)); }
+  PETSC_NO_COPY_POLICY(InnerComm);
+
+  operator MPI_Comm() const { return inner; }
+
+ private:
+  MPI_Comm inner = MPI_COMM_NULL;
+};
+
+/// @brief Set up DMDAs by the inner communicator and the creation parameters except for `dof`, and then by `dof`
+std::map<std::pair<MPI_Comm, std::vector<Int>>, std::map<Int, ::DM>> layoutCache;
+bool layoutCacheRegistered = false;
+
+PetscErrorCode DestroyLayoutCache() {
+  PetscFunctionBeginUser;
+  for (auto& [layout, dms] : layoutCache) {
+    for (auto& [dof, dm] : dms) {
+      PetscCall(DMDestroy(&dm));
+    }
+  }
+  layoutCache.clear();
+  layoutCacheRegistered = false;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/// @brief Appends the ownership ranges to the layout key, `-1` marks the default ones
+void AppendRanges(std::vector<Int>& layout, Int procs, const Int* ranges) {
+  if (!ranges) {
+    layout.emplace_back(-1);
+    return;
+  }
+  if (procs < 1) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+  layout.emplace_back(procs);
+  layout.insert(layout.end(), ranges, ranges + procs);
+}
+
+/// @brief Returns the index set composed on `obj` under the `key`, `create(is)` makes it on the first call
+template<typename Create>
+IS GetComposedIS(PetscObject obj, const std::string& key, Create&& create) {
+  IS is;
+  _p_IS** raw = is;
+  PetscCallThrow(PetscObjectQuery(obj, key.c_str(), (PetscObject*)raw));
+  if (*raw) {
+    PetscCallThrow(PetscObjectReference((PetscObject)*raw));
+  }
+  else {
+    create(raw);
+    PetscCallThrow(PetscObjectCompose(obj, key.c_str(), is));
+  }
+  return is;
+}
+
+/// @brief Points per block of the transposes, so that a block of all fields stays in L1 cache
+constexpr Int transposeBlock = 64;
+
+/// @brief Spreads `n` interlaced points into `dof` rows, which are `stride` elements apart
+void Deinterlace(const Scalar* in, Int n, Int dof, Scalar* out, Int stride) {
+  if (dof == 1) {
+    std::copy(in, in + n, out);
+    return;
+  }
+  for (Int b = 0; b < n; b += transposeBlock) {
+    Int e = std::min(n, b + transposeBlock);
+    for (Int f = 0; f < dof; ++f) {
+      Scalar* row = out + f * stride;
+      for (Int p = b; p < e; ++p) {
+        row[p] = in[p * dof + f];
+      }
+    }
+  }
+}
+
+/// @brief Writes only the fields marked in `selected` if it is given
+void Interlace(const Scalar* in, Int stride, Int n, Int dof, Scalar* out, const char* selected = nullptr) {
+  if (dof == 1) {
+    std::copy(in, in + n, out);
+    return;
+  }
+  for (Int b = 0; b < n; b += transposeBlock) {
+    Int e = std::min(n, b + transposeBlock);
+    for (Int f = 0; f < dof; ++f) {
+      if (selected && !selected[f]) {
+        continue;
+      }
+      const Scalar* row = in + f * stride;
+      for (Int p = b; p < e; ++p) {
+        out[p * dof + f] = row[p];
+      }
+    }
+  }
+}
+
+/// @brief Splits `weights` into `parts` contiguous ranges of nearly equal sum, at least `minWidth` long
+std::vector<Int> CutRanges(const std::vector<Real>& weights, Int parts, Int minWidth) {
+  Int n = (Int)weights.size();
+  if (n < parts * minWidth) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+
+  std::vector<Real> prefix(n + 1, 0.0);
+  for (Int i = 0; i < n; ++i) {
+    prefix[i + 1] = prefix[i] + weights[i];
+  }
+
+  std::vector<Int> ranges(parts);
+  Int start = 0;
+  for (Int p = 0; p < parts - 1; ++p) {
+    Real target = prefix[n] * (Real)(p + 1) / (Real)parts;
+    Int lo = start + minWidth;
+    Int hi = n - (parts - 1 - p) * minWidth;
+
+    Int end = std::lower_bound(prefix.begin() + lo, prefix.begin() + hi + 1, target) - prefix.begin();
+    if (end > hi) {
+      end = hi;
+    }
+    else if (end > lo && target - prefix[end - 1] < prefix[end] - target) {
+      --end;
+    }
+    ranges[p] = end - start;
+    start = end;
+  }
+  ranges[parts - 1] = n - start;
+  return ranges;
+}
+
+void ShrinkGhosts(Int& start, Int& size, Int ghostStart, Int ghostSize, Int width) {
+  Int lo = ghostStart < start ? ghostStart + width : start;
+  Int hi = ghostStart + ghostSize > start + size ? ghostStart + ghostSize - width : start + size;
+  start = lo;
+  size = std::max<Int>(0, hi - lo);
+}
+
+#ifdef PETSC_HAVE_MPIIO
+/// @brief Checks the box and the components of `DA::LoadRegion()`, empty components are all of them
+std::vector<Int> PickComponents(Int3 lo, Int3 hi, Int3 sizes, Int dof, const std::vector<Int>& components) {
+  if (lo.x < 0 || lo.y < 0 || lo.z < 0 || hi.x > sizes.x || hi.y > sizes.y || hi.z > sizes.z ||
+      lo.x >= hi.x || lo.y >= hi.y || lo.z >= hi.z) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+  std::vector<Int> picked = components;
+  if (picked.empty()) {
+    for (Int c = 0; c < dof; ++c) {
+      picked.emplace_back(c);
+    }
+  }
+  for (Int c : picked) {
+    if (c < 0 || c >= dof) {
+      PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+    }
+  }
+  return picked;
+}
+
+/// @brief MPI datatype freed on destruction
+class Datatype {
+ public:
+  Datatype() = default;
+  ~Datatype() noexcept(false) {
+    if (type != MPI_DATATYPE_NULL) {
+      PetscCallMPIThrow(MPI_Type_free(&type));
+    }
+  }
+  PETSC_NO_COPY_POLICY(Datatype);
+
+  operator MPI_Datatype() const { return type; }
+  operator MPI_Datatype*() { return &type; }
+
+ private:
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+};
+
+/// @brief Reads the points `[a, a + n)` of the vector saved at the MPI-IO offset of `viewer` into `data`
+/// in the natural ordering, then moves the offset past the vector. Collective on the viewer.
+void ReadSubarray(Binary& viewer, Int3 sizes, Int dof, const std::vector<Int>& picked, Int3 a, Int3 n, Scalar* data) {
+  MPI_File fd = viewer.GetMPIIODescriptor();
+  MPI_Offset base = viewer.GetMPIIOOffset();
+  Int total = sizes.x * sizes.y * sizes.z * dof;
+  Int points = n.x * n.y * n.z;
+
+  // File views need increasing displacements, so distinct components are read in order and permuted after
+  std::vector<Int> sorted = picked;
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  bool permuted = sorted != picked;
+
+  Int nc = (Int)sorted.size();
+  Int count = points * nc;
+  if (count > PETSC_MPI_INT_MAX || std::max({sizes.x, sizes.y, sizes.z}) > PETSC_MPI_INT_MAX) {
+    PetscCallThrow(PETSC_ERR_SUP);
+  }
+
+  MPI_Offset header = 0;
+  if (!viewer.GetSkipHeader()) {
+    Int record[2];
+    PetscCallMPIThrow(MPI_File_set_view(fd, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL));
+    PetscCallMPIThrow(MPI_File_read_at_all(fd, base, record, (MPIInt)sizeof(record), MPI_BYTE, MPI_STATUS_IGNORE));
+#if !defined(PETSC_WORDS_BIGENDIAN)
+    PetscCallThrow(PetscByteSwap(record, PETSC_INT, 2));
+#endif
+    if (record[0] != VEC_FILE_CLASSID || record[1] != total) {
+      PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+    }
+    header = sizeof(record);
+  }
+
+  // A point takes the picked components and spans all of them, the box is a subarray of such points
+  std::vector<MPIInt> displacements(sorted.begin(), sorted.end());
+  Datatype components, point, box;
+  PetscCallMPIThrow(MPI_Type_create_indexed_block((MPIInt)nc, 1, displacements.data(), MPIU_SCALAR, components));
+  PetscCallMPIThrow(MPI_Type_create_resized(components, 0, dof * sizeof(Scalar), point));
+
+  if (count > 0) {
+    MPIInt shape[3] = {(MPIInt)sizes.z, (MPIInt)sizes.y, (MPIInt)sizes.x};
+    MPIInt subshape[3] = {(MPIInt)n.z, (MPIInt)n.y, (MPIInt)n.x};
+    MPIInt starts[3] = {(MPIInt)a.z, (MPIInt)a.y, (MPIInt)a.x};
+    PetscCallMPIThrow(MPI_Type_create_subarray(3, shape, subshape, starts, MPI_ORDER_C, point, box));
+  }
+  else {
+    PetscCallMPIThrow(MPI_Type_contiguous(0, MPIU_SCALAR, box));
+  }
+  PetscCallMPIThrow(MPI_Type_commit(box));
+
+  std::vector<Scalar> buffer(permuted ? count : 0);
+  Scalar* read = permuted ? buffer.data() : data;
+
+  PetscCallMPIThrow(MPI_File_set_view(fd, base + header, MPIU_SCALAR, box, "native", MPI_INFO_NULL));
+  PetscCallMPIThrow(MPI_File_read_all(fd, read, (MPIInt)count, MPIU_SCALAR, MPI_STATUS_IGNORE));
+  PetscCallMPIThrow(MPI_File_set_view(fd, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL));
+
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  PetscCallThrow(PetscByteSwap(read, PETSC_SCALAR, count));
+#endif
+
+  if (permuted) {
+    std::vector<Int> position(picked.size());
+    for (std::size_t c = 0; c < picked.size(); ++c) {
+      position[c] = std::lower_bound(sorted.begin(), sorted.end(), picked[c]) - sorted.begin();
+    }
+    for (Int p = 0; p < points; ++p) {
+      for (std::size_t c = 0; c < picked.size(); ++c) {
+        data[p * picked.size() + c] = buffer[p * nc + position[c]];
+      }
+    }
+  }
+  viewer.AddMPIIOOffset(header + (MPI_Offset)total * sizeof(Scalar));
+}
+#endif
+
+}
+
+DA::DA(std::string_view name)
+    : DA(PETSC_COMM_WORLD, name) {}
+
+DA::DA(MPI_Comm comm, std::string_view name) {
+  PetscCallThrow(DMDACreate(comm, &that));
+  if (!name.empty()) {
+    PetscCallThrow(PetscObjectSetName(*this, name.data()));
+  }
 }
 
 /* static */ DA DA::Create() {
+  return Create(PETSC_COMM_WORLD);
+}
+
+/* static */ DA DA::Create(MPI_Comm comm) {
   DA da;
-  PetscCallThrow(DMDACreate(PETSC_COMM_WORLD, da));
+  PetscCallThrow(DMDACreate(comm, da));
   return da;
 }
 
 /* static */ DA DA::Create1d(BoundaryType boundary, Int global, Int dof, Int s, const Int* ranges) {
+  return Create1d(PETSC_COMM_WORLD, boundary, global, dof, s, ranges);
+}
+
+/* static */ DA DA::Create1d(MPI_Comm comm, BoundaryType boundary, Int global, Int dof, Int s, const Int* ranges) {
   DA da;
-  PetscCallThrow(DMDACreate1d(PETSC_COMM_WORLD,
+  PetscCallThrow(DMDACreate1d(comm,
     boundary, global, dof, s, ranges, da));
   return da;
 }
 
 /* static */ DA DA::Create2d(Two<BoundaryType> boundary, StencilType type, Two<Int> global, Two<Int> procs, Int dof, Int s, Two<const Int*> ranges) {
+  return Create2d(PETSC_COMM_WORLD, boundary, type, global, procs, dof, s, ranges);
+}
+
+/* static */ DA DA::Create2d(MPI_Comm comm, Two<BoundaryType> boundary, StencilType type, Two<Int> global, Two<Int> procs, Int dof, Int s, Two<const Int*> ranges) {
   DA da;
-  PetscCallThrow(DMDACreate2d(PETSC_COMM_WORLD,
+  PetscCallThrow(DMDACreate2d(comm,
     boundary.x, boundary.y, type, global.x, global.y, procs.x, procs.y, dof, s, ranges.x, ranges.y, da));
   return da;
 }
 
 /* static */ DA DA::Create3d(Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs, Int dof, Int s, Three<const Int*> ranges) {
+  return Create3d(PETSC_COMM_WORLD, boundary, type, global, procs, dof, s, ranges);
+}
+
+/* static */ DA DA::Create3d(MPI_Comm comm, Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs, Int dof, Int s, Three<const Int*> ranges) {
   DA da;
-  PetscCallThrow(DMDACreate3d(PETSC_COMM_WORLD,
+  PetscCallThrow(DMDACreate3d(comm,
     boundary.x, boundary.y, boundary.z, type, global.x, global.y, global.z, procs.x, procs.y, procs.z, dof, s, ranges.x, ranges.y, ranges.z, da));
   return da;
 }
 
+template<typename Create>
+/* static */ DA DA::FromLayoutCache(MPI_Comm comm, std::vector<Int> layout, Int dof, Create&& create) {
+  if (!layoutCacheRegistered) {
+    PetscCallThrow(PetscRegisterFinalize(DestroyLayoutCache));
+    layoutCacheRegistered = true;
+  }
+
+  // The cached DMDAs hold the inner communicator, so its handle identifies the communicator
+  InnerComm inner(comm);
+  auto& dms = layoutCache[std::make_pair((MPI_Comm)inner, std::move(layout))];
+  auto it = dms.find(dof);
+  if (it == dms.end()) {
+    ::DM dm;
+    if (dms.empty()) {
+      DA da = create();
+      da.SetUp();
+      dm = da.that;
+      da.that = nullptr;
+    }
+    else {
+      PetscCallThrow(DMDACreateCompatibleDMDA(dms.begin()->second, dof, &dm));
+    }
+    it = dms.emplace(dof, dm).first;
+  }
+
+  PetscCallThrow(PetscObjectReference((PetscObject)it->second));
+  return DA(it->second);
+}
+
+/* static */ DA DA::CreateCached1d(BoundaryType boundary, Int global, Int dof, Int s, const Int* ranges) {
+  return CreateCached1d(PETSC_COMM_WORLD, boundary, global, dof, s, ranges);
+}
+
+/* static */ DA DA::CreateCached1d(MPI_Comm comm, BoundaryType boundary, Int global, Int dof, Int s, const Int* ranges) {
+  MPIInt size;
+  PetscCallMPIThrow(MPI_Comm_size(comm, &size));
+
+  std::vector<Int> layout{1, global, (Int)boundary, s};
+  AppendRanges(layout, size, ranges);
+  return FromLayoutCache(comm, std::move(layout), dof, [&]() {
+    return Create1d(comm, boundary, global, dof, s, ranges);
+  });
+}
+
+/* static */ DA DA::CreateCached2d(Two<BoundaryType> boundary, StencilType type, Int2 global, Int2 procs, Int dof, Int s, Two<const Int*> ranges) {
+  return CreateCached2d(PETSC_COMM_WORLD, boundary, type, global, procs, dof, s, ranges);
+}
+
+/* static */ DA DA::CreateCached2d(MPI_Comm comm, Two<BoundaryType> boundary, StencilType type, Int2 global, Int2 procs, Int dof, Int s, Two<const Int*> ranges) {
+  std::vector<Int> layout{2, global.x, global.y, procs.x, procs.y, (Int)boundary.x, (Int)boundary.y, (Int)type, s};
+  AppendRanges(layout, procs.x, ranges.x);
+  AppendRanges(layout, procs.y, ranges.y);
+  return FromLayoutCache(comm, std::move(layout), dof, [&]() {
+    return Create2d(comm, boundary, type, global, procs, dof, s, ranges);
+  });
+}
+
+/* static */ DA DA::CreateCached3d(Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs, Int dof, Int s, Three<const Int*> ranges) {
+  return CreateCached3d(PETSC_COMM_WORLD, boundary, type, global, procs, dof, s, ranges);
+}
+
+/* static */ DA DA::CreateCached3d(MPI_Comm comm, Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs, Int dof, Int s, Three<const Int*> ranges) {
+  std::vector<Int> layout{3, global.x, global.y, global.z, procs.x, procs.y, procs.z, (Int)boundary.x, (Int)boundary.y, (Int)boundary.z, (Int)type, s};
+  AppendRanges(layout, procs.x, ranges.x);
+  AppendRanges(layout, procs.y, ranges.y);
+  AppendRanges(layout, procs.z, ranges.z);
+  return FromLayoutCache(comm, std::move(layout), dof, [&]() {
+    return Create3d(comm, boundary, type, global, procs, dof, s, ranges);
+  });
+}
+
+DA DA::CloneWithDof(Int dof) const {
+  ::DM dm;
+  PetscCallThrow(DMDACreateCompatibleDMDA(that, dof, &dm));
+  return DA(dm);
+}
+
 void DA::SetSizes(Int3 global) {
   PetscCallThrow(DMDASetSizes(that, global.x, global.y, global.z));
 }
@@ -49,7 +431,7 @@ void DA::SetNumProcs(Int3 procs) {
 
 Int3 DA::GetNumProcs() const {
   Int3 procs;
-  PetscCallThrow(DMDAGetInfo(that, NULL, NULL, NULL, NULL, &procs.x, &procs.y, &procs.y, NULL, NULL, NULL, NULL, NULL, NULL));
+  PetscCallThrow(DMDAGetInfo(that, NULL, NULL, NULL, NULL, &procs.x, &procs.y, &procs.z, NULL, NULL, NULL, NULL, NULL, NULL));
   return procs;
 }
 
@@ -115,6 +497,313 @@ std::pair<Int3, Int3> DA::GetGhostCorners() const {
   return std::make_pair(corner, size);
 }
 
+Vec DA::CreateNaturalVector() const {
+  Vec vec;
+  PetscCallThrow(DMDACreateNaturalVector(that, vec));
+  return vec;
+}
+
+void DA::GlobalToNatural(const Vec& global, InsertMode mode, Vec& natural) const {
+  GlobalToNaturalBegin(global, mode, natural);
+  GlobalToNaturalEnd(global, mode, natural);
+}
+
+void DA::GlobalToNaturalBegin(const Vec& global, InsertMode mode, Vec& natural) const {
+  PetscCallThrow(DMDAGlobalToNaturalBegin(that, global, mode, natural));
+}
+
+void DA::GlobalToNaturalEnd(const Vec& global, InsertMode mode, Vec& natural) const {
+  PetscCallThrow(DMDAGlobalToNaturalEnd(that, global, mode, natural));
+}
+
+void DA::NaturalToGlobal(const Vec& natural, InsertMode mode, Vec& global) const {
+  NaturalToGlobalBegin(natural, mode, global);
+  NaturalToGlobalEnd(natural, mode, global);
+}
+
+void DA::NaturalToGlobalBegin(const Vec& natural, InsertMode mode, Vec& global) const {
+  PetscCallThrow(DMDANaturalToGlobalBegin(that, natural, mode, global));
+}
+
+void DA::NaturalToGlobalEnd(const Vec& natural, InsertMode mode, Vec& global) const {
+  PetscCallThrow(DMDANaturalToGlobalEnd(that, natural, mode, global));
+}
+
+Vec DA::GetNaturalSlice(const Vec& global, const Box& box, Int component) const {
+  MPI_Comm comm = PetscObjectComm(*this);
+  const Int3& c = box.first;
+  const Int3& n = box.second;
+  auto sizes = GetSizes();
+  Int dof = GetDof();
+
+  if (c.x < 0 || c.y < 0 || c.z < 0 || n.x < 0 || n.y < 0 || n.z < 0 ||
+      c.x + n.x > sizes.x || c.y + n.y > sizes.y || c.z + n.z > sizes.z || component < PETSC_DECIDE ||
+      component >= dof) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+
+  Int components = component == PETSC_DECIDE ? dof : 1;
+  Int total = n.x * n.y * n.z * components;
+  Int local = PETSC_DECIDE;
+  PetscCallThrow(PetscSplitOwnership(comm, &local, &total));
+
+  Vec slice(comm, local, total);
+
+  std::string key = "Petsc::DA::GetNaturalSlice";
+  for (Int v : {c.x, c.y, c.z, n.x, n.y, n.z, component}) {
+    key += "_" + std::to_string(v);
+  }
+
+  VecScatter scatter = nullptr;
+  PetscCallThrow(PetscObjectQuery(*this, key.c_str(), (PetscObject*)&scatter));
+  if (!scatter) {
+    Int start = 0;
+    PetscCallMPIThrow(MPI_Exscan(&local, &start, 1, MPIU_INT, MPI_SUM, comm));
+
+    // The slice is split evenly, its entries are mapped from the natural indices to the PETSc ones.
+    // The AO of the DA orders the degrees of freedom, not the grid points.
+    std::vector<Int> points(local);
+    for (Int e = 0; e < local; ++e) {
+      Int p = (start + e) / components;
+      Int i = c.x + p % n.x;
+      Int j = c.y + (p / n.x) % n.y;
+      Int k = c.z + p / (n.x * n.y);
+      Int l = component == PETSC_DECIDE ? (start + e) % dof : component;
+      points[e] = (i + sizes.x * (j + sizes.y * k)) * dof + l;
+    }
+
+    AO ao;
+    PetscCallThrow(DMDAGetAO(that, &ao));
+    PetscCallThrow(AOApplicationToPetsc(ao, local, points.data()));
+
+    ::IS is;
+    PetscCallThrow(ISCreateGeneral(comm, local, points.data(), PETSC_USE_POINTER, &is));
+    PetscCallThrow(VecScatterCreate(global, is, slice, NULL, &scatter));
+    PetscCallThrow(ISDestroy(&is));
+
+    PetscCallThrow(PetscObjectCompose(*this, key.c_str(), (PetscObject)scatter));
+    PetscCallThrow(VecScatterDestroy(&scatter));
+    PetscCallThrow(PetscObjectQuery(*this, key.c_str(), (PetscObject*)&scatter));
+  }
+
+  PetscCallThrow(VecScatterBegin(scatter, global, slice, INSERT_VALUES, SCATTER_FORWARD));
+  PetscCallThrow(VecScatterEnd(scatter, global, slice, INSERT_VALUES, SCATTER_FORWARD));
+  return slice;
+}
+
+#ifdef PETSC_HAVE_MPIIO
+Vec DA::LoadRegion(Binary& viewer, Int3 lo, Int3 hi, const std::vector<Int>& components) const {
+  Int3 sizes = GetSizes();
+  auto picked = PickComponents(lo, hi, sizes, GetDof(), components);
+
+  DA region(PetscObjectComm(viewer));
+  region.SetDimension(GetDimension());
+  region.SetSizes({hi.x - lo.x, hi.y - lo.y, hi.z - lo.z});
+  region.SetDof((Int)picked.size());
+  region.SetStencilWidth(0);
+  region.SetUp();
+
+  for (Int c = 0; c < (Int)picked.size(); ++c) {
+    if (const char* name = GetFieldName(picked[c])) {
+      region.SetFieldName(c, name);
+    }
+  }
+
+  // The vector keeps a reference to the region DA
+  auto vec = region.CreateGlobalVector();
+  auto [corner, size] = region.GetCorners();
+  {
+    auto array = vec.GetArray(Write);
+    Int3 a = {lo.x + corner.x, lo.y + corner.y, lo.z + corner.z};
+    ReadSubarray(viewer, sizes, GetDof(), picked, a, size, array);
+  }
+  return vec;
+}
+
+std::vector<Scalar> DA::LoadRegionLocal(Binary& viewer, Int3 lo, Int3 hi, const std::vector<Int>& components) const {
+  Int3 sizes = GetSizes();
+  auto picked = PickComponents(lo, hi, sizes, GetDof(), components);
+
+  Int3 n = {hi.x - lo.x, hi.y - lo.y, hi.z - lo.z};
+  std::vector<Scalar> values(n.x * n.y * n.z * picked.size());
+  ReadSubarray(viewer, sizes, GetDof(), picked, lo, n, values.data());
+  return values;
+}
+#endif
+
+IS DA::BoxIS(Int3 lo, Int3 hi, const std::vector<Int>& components) const {
+  std::string key = "Petsc::DA::BoxIS";
+  for (Int v : {lo.x, lo.y, lo.z, hi.x, hi.y, hi.z}) {
+    key += "_" + std::to_string(v);
+  }
+  key += "_c";
+  for (Int v : components) {
+    key += "_" + std::to_string(v);
+  }
+
+  return GetComposedIS(*this, key, [&](_p_IS** is) {
+    MPI_Comm comm = PetscObjectComm(*this);
+    auto [corner, size] = GetCorners();
+    Int dof = GetDof();
+
+    bool all = components.empty() || (Int)components.size() == dof;
+    for (Int c = 0; c < (Int)components.size(); ++c) {
+      if (components[c] < 0 || components[c] >= dof) {
+        PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+      }
+      all = all && components[c] == c;
+    }
+
+    Int3 a, n;
+    auto intersect = [](Int lo, Int hi, Int start, Int size, Int& first, Int& count) {
+      first = std::max(lo, start);
+      count = std::max<Int>(0, std::min(hi, start + size) - first);
+    };
+    intersect(lo.x, hi.x, corner.x, size.x, a.x, n.x);
+    intersect(lo.y, hi.y, corner.y, size.y, a.y, n.y);
+    intersect(lo.z, hi.z, corner.z, size.z, a.z, n.z);
+    Int points = n.x * n.y * n.z;
+
+    Int rstart = 0;
+    Int owned = size.x * size.y * size.z * dof;
+    PetscCallMPIThrow(MPI_Exscan(&owned, &rstart, 1, MPIU_INT, MPI_SUM, comm));
+
+    auto offset = [&](Int k, Int j, Int i) {
+      return rstart + dof * (((k - corner.z) * size.y + (j - corner.y)) * size.x + (i - corner.x));
+    };
+
+    // Points are contiguous when the region takes whole owned rows and planes, except the outermost ones
+    bool contiguous =
+      (n.z == 1 || (n.y == size.y && n.x == size.x)) &&
+      (n.y == 1 || n.x == size.x);
+
+    if (points == 0) {
+      PetscCallThrow(ISCreateStride(comm, 0, 0, 1, is));
+    }
+    else if (contiguous && all) {
+      PetscCallThrow(ISCreateStride(comm, points * dof, offset(a.z, a.y, a.x), 1, is));
+    }
+    else if (contiguous && components.size() == 1) {
+      PetscCallThrow(ISCreateStride(comm, points, offset(a.z, a.y, a.x) + components[0], dof, is));
+    }
+    else {
+      Int nc = all ? 1 : (Int)components.size();
+      std::vector<Int> indices;
+      indices.reserve(points * nc);
+      for (Int k = a.z; k < a.z + n.z; ++k) {
+      for (Int j = a.y; j < a.y + n.y; ++j) {
+      for (Int i = a.x; i < a.x + n.x; ++i) {
+        if (all) {
+          indices.emplace_back(offset(k, j, i) / dof);
+          continue;
+        }
+        for (Int c : components) {
+          indices.emplace_back(offset(k, j, i) + c);
+        }
+      }}}
+
+      if (all) {
+        PetscCallThrow(ISCreateBlock(comm, dof, points, indices.data(), PETSC_COPY_VALUES, is));
+      }
+      else {
+        PetscCallThrow(ISCreateGeneral(comm, (Int)indices.size(), indices.data(), PETSC_COPY_VALUES, is));
+      }
+    }
+  });
+}
+
+IS DA::SliceIS(Int axis, Int position, Int component) const {
+  Int3 lo = {0, 0, 0};
+  Int3 hi = GetSizes();
+  switch (axis) {
+    case 0: lo.x = position; hi.x = position + 1; break;
+    case 1: lo.y = position; hi.y = position + 1; break;
+    case 2: lo.z = position; hi.z = position + 1; break;
+    default: PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+  if (component == PETSC_DECIDE) {
+    return BoxIS(lo, hi);
+  }
+  return BoxIS(lo, hi, {component});
+}
+
+IS DA::ComponentIS(Int component) const {
+  return BoxIS({0, 0, 0}, GetSizes(), {component});
+}
+
+DA::Box DA::GetPhysicalInterior() const {
+  auto [corner, size] = GetCorners();
+  auto global = GetSizes();
+  auto boundary = GetBoundaryType();
+  Int dim = GetDimension();
+  Int s = GetStencilWidth();
+
+  ShrinkToInterior(corner.x, size.x, global.x, s, boundary.x);
+  if (dim > 1) {
+    ShrinkToInterior(corner.y, size.y, global.y, s, boundary.y);
+  }
+  if (dim > 2) {
+    ShrinkToInterior(corner.z, size.z, global.z, s, boundary.z);
+  }
+  return std::make_pair(corner, size);
+}
+
+DA::Box DA::GetGhostInterior() const {
+  auto [corner, size] = GetCorners();
+  auto [ghostCorner, ghostSize] = GetGhostCorners();
+  Int s = GetStencilWidth();
+
+  ShrinkFromGhosts(corner.x, size.x, ghostCorner.x, ghostSize.x, s);
+  ShrinkFromGhosts(corner.y, size.y, ghostCorner.y, ghostSize.y, s);
+  ShrinkFromGhosts(corner.z, size.z, ghostCorner.z, ghostSize.z, s);
+  return std::make_pair(corner, size);
+}
+
+DA::Box DA::GetValidRegion(Int width) const {
+  auto [corner, size] = GetCorners();
+  auto [ghostCorner, ghostSize] = GetGhostCorners();
+
+  ShrinkGhosts(corner.x, size.x, ghostCorner.x, ghostSize.x, width);
+  ShrinkGhosts(corner.y, size.y, ghostCorner.y, ghostSize.y, width);
+  ShrinkGhosts(corner.z, size.z, ghostCorner.z, ghostSize.z, width);
+  return std::make_pair(corner, size);
+}
+
+/* static */ std::vector<DA::Box> DA::GetShell(const Box& outer, const Box& inner) {
+  std::vector<Box> shell;
+
+  auto empty = [](const Box& box) {
+    return box.second.x <= 0 || box.second.y <= 0 || box.second.z <= 0;
+  };
+  if (empty(inner)) {
+    if (!empty(outer)) {
+      shell.emplace_back(outer);
+    }
+    return shell;
+  }
+
+  const Int3& os = outer.first;
+  const Int3& is = inner.first;
+  Int3 oe(os.x + outer.second.x, os.y + outer.second.y, os.z + outer.second.z);
+  Int3 ie(is.x + inner.second.x, is.y + inner.second.y, is.z + inner.second.z);
+
+  auto add = [&](Int3 lo, Int3 hi) {
+    Box slab(lo, Int3(hi.x - lo.x, hi.y - lo.y, hi.z - lo.z));
+    if (!empty(slab)) {
+      shell.emplace_back(slab);
+    }
+  };
+
+  // z-slabs span the whole box, y-slabs the inner z range, x-slabs the inner z and y ranges
+  add({os.x, os.y, os.z}, {oe.x, oe.y, is.z});
+  add({os.x, os.y, ie.z}, {oe.x, oe.y, oe.z});
+  add({os.x, os.y, is.z}, {oe.x, is.y, ie.z});
+  add({os.x, ie.y, is.z}, {oe.x, oe.y, ie.z});
+  add({os.x, is.y, is.z}, {is.x, ie.y, ie.z});
+  add({ie.x, is.y, is.z}, {oe.x, ie.y, ie.z});
+  return shell;
+}
+
 void DA::SetFieldName(Int nf, const char* name) {
   PetscCallThrow(DMDASetFieldName(that, nf, name));
 }
@@ -135,6 +824,103 @@ const char** DA::GetFieldNames() const  {
   return names;
 }
 
+Int DA::GetFieldIndex(std::string_view name) const {
+  Int dof = GetDof();
+  for (Int f = 0; f < dof; ++f) {
+    const char* field = GetFieldName(f);
+    if (field && name == field) {
+      return f;
+    }
+  }
+  PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  return -1;
+}
+
+Vec DA::CreateFieldVector() const {
+  auto [corner, size] = GetCorners();
+  return Vec(PetscObjectComm(*this), size.x * size.y * size.z, PETSC_DETERMINE);
+}
+
+DA DA::Balance(const Vec& cost) const {
+  MPI_Comm comm = PetscObjectComm(*this);
+  auto [corner, size] = GetCorners();
+  auto global = GetSizes();
+  auto procs = GetNumProcs();
+  Int dim = GetDimension();
+  Int dof = GetDof();
+  Int s = GetStencilWidth();
+
+  if (cost.GetLocalSize() != size.x * size.y * size.z) {
+    PetscCallThrow(PETSC_ERR_ARG_SIZ);
+  }
+
+  // Marginal costs of the planes along each axis, the DA partition is a tensor product of them
+  std::vector<Real> weights(global.x + global.y + global.z, 0.0);
+  Real* wx = weights.data();
+  Real* wy = wx + global.x;
+  Real* wz = wy + global.y;
+  {
+    auto array = cost.GetArrayRead();
+    const Scalar* c = array;
+    for (Int k = 0; k < size.z; ++k) {
+    for (Int j = 0; j < size.y; ++j) {
+    for (Int i = 0; i < size.x; ++i) {
+      Real w = PetscRealPart(c[(k * size.y + j) * size.x + i]);
+      wx[corner.x + i] += w;
+      wy[corner.y + j] += w;
+      wz[corner.z + k] += w;
+    }}}
+  }
+  PetscCallMPIThrow(MPI_Allreduce(MPI_IN_PLACE, weights.data(), (MPIInt)weights.size(), MPIU_REAL, MPIU_SUM, comm));
+
+  Int minWidth = std::max<Int>(1, s);
+  auto lx = CutRanges(std::vector<Real>(wx, wx + global.x), procs.x, minWidth);
+  auto ly = CutRanges(std::vector<Real>(wy, wy + global.y), procs.y, dim > 1 ? minWidth : 1);
+  auto lz = CutRanges(std::vector<Real>(wz, wz + global.z), procs.z, dim > 2 ? minWidth : 1);
+
+  DA da(comm);
+  da.SetDimension(dim);
+  da.SetSizes(global);
+  da.SetNumProcs(procs);
+  da.SetBoundaryType(GetBoundaryType());
+  da.SetDof(dof);
+  da.SetStencilType(GetStencilType());
+  da.SetStencilWidth(s);
+  da.SetOwnershipRanges({lx.data(), dim > 1 ? ly.data() : nullptr, dim > 2 ? lz.data() : nullptr});
+  da.SetUp();
+
+  for (Int f = 0; f < dof; ++f) {
+    if (const char* name = GetFieldName(f)) {
+      da.SetFieldName(f, name);
+    }
+  }
+  return da;
+}
+
+Vec DA::CreateCostFromTime(Real stepTime) const {
+  auto cost = CreateFieldVector();
+  Int points = cost.GetLocalSize();
+  cost.Set(points > 0 ? stepTime / (Real)points : 0.0);
+  return cost;
+}
+
+Vec DA::Redistribute(const Vec& from, const DA& to) const {
+  // Both DAs share the natural ordering, so the data is moved between their natural vectors
+  auto naturalFrom = CreateNaturalVector();
+  auto naturalTo = to.CreateNaturalVector();
+  GlobalToNatural(from, INSERT_VALUES, naturalFrom);
+
+  // The ownership ranges differ, so each process gathers its target range from wherever it lies
+  auto [start, end] = naturalTo.GetOwnershipRange();
+  auto range = IS::CreateStride(PetscObjectComm(to), end - start, start, 1);
+  Scatter scatter(naturalFrom, &range, naturalTo, &range);
+  scatter.Apply(naturalFrom, naturalTo, INSERT_VALUES);
+
+  auto result = to.CreateGlobalVector();
+  to.NaturalToGlobal(naturalTo, INSERT_VALUES, result);
+  return result;
+}
+
 void DA::SetCoordinateName(Int nf, const char* name)  {
   PetscCallThrow(DMDASetCoordinateName(that, nf, name));
 }
@@ -145,4 +931,101 @@ const char* DA::GetCoordinateName(Int nf) const  {
   return name;
 }
 
+DA::FieldView DA::GetFieldView(Vec& vec, GetArrayType type) const {
+  return FieldView(*this, vec, GetCorners(), type);
+}
+
+DA::FieldView DA::GetFieldView(Vec& vec, const Box& box, GetArrayType type) const {
+  return FieldView(*this, vec, box, type);
+}
+
+DA::FieldView::FieldView(const DA& da, Vec& vec, const Box& box, GetArrayType type)
+    : da(da), vec(vec), type(type), box(box) {
+  if (!(type == Default || type == Read || type == Write)) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+  dof = da.GetDof();
+
+  auto [corner, size] = da.GetCorners();
+  auto [ghostCorner, ghostSize] = da.GetGhostCorners();
+
+  Int localSize = vec.GetLocalSize();
+  if (localSize == ghostSize.x * ghostSize.y * ghostSize.z * dof) {
+    arrayCorner = ghostCorner;
+    arraySize = ghostSize;
+  }
+  else if (localSize == size.x * size.y * size.z * dof) {
+    arrayCorner = corner;
+    arraySize = size;
+  }
+  else {
+    PetscCallThrow(PETSC_ERR_ARG_SIZ);
+  }
+
+  auto inside = [](Int start, Int n, Int arrayStart, Int arrayN) {
+    return n >= 0 && start >= arrayStart && start + n <= arrayStart + arrayN;
+  };
+  const Int3& c = box.first;
+  const Int3& n = box.second;
+  if (!inside(c.x, n.x, arrayCorner.x, arraySize.x) ||
+      !inside(c.y, n.y, arrayCorner.y, arraySize.y) ||
+      !inside(c.z, n.z, arrayCorner.z, arraySize.z)) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+
+  points = n.x * n.y * n.z;
+  fields.assign(dof * points, 0.0);
+
+  if (type == Write) {
+    selected.assign(dof, false);
+    return;
+  }
+
+  const Scalar* array;
+  PetscCallThrow(VecGetArrayRead(vec, &array));
+
+  #pragma omp parallel for collapse(2) if(points >= 4096)
+  for (Int k = c.z; k < c.z + n.z; ++k) {
+  for (Int j = c.y; j < c.y + n.y; ++j) {
+    Int row = ((k - arrayCorner.z) * arraySize.y + (j - arrayCorner.y)) * arraySize.x + (c.x - arrayCorner.x);
+    Deinterlace(array + row * dof, n.x, dof, fields.data() + Offset(k, j, c.x), points);
+  }}
+
+  PetscCallThrow(VecRestoreArrayRead(vec, &array));
+}
+
+void DA::FieldView::WriteBack() {
+  // Fields of a `Write` view that were never accessed keep the values of the vector
+  const char* mask = nullptr;
+  if (type == Write) {
+    if (std::none_of(selected.begin(), selected.end(), [](char s) { return s; })) {
+      return;
+    }
+    if (!std::all_of(selected.begin(), selected.end(), [](char s) { return s; })) {
+      mask = selected.data();
+    }
+  }
+
+  Scalar* array;
+  PetscCallThrow(VecGetArray(vec, &array));
+
+  const Int3& c = box.first;
+  const Int3& n = box.second;
+
+  #pragma omp parallel for collapse(2) if(points >= 4096)
+  for (Int k = c.z; k < c.z + n.z; ++k) {
+  for (Int j = c.y; j < c.y + n.y; ++j) {
+    Int row = ((k - arrayCorner.z) * arraySize.y + (j - arrayCorner.y)) * arraySize.x + (c.x - arrayCorner.x);
+    Interlace(fields.data() + Offset(k, j, c.x), points, n.x, dof, array + row * dof, mask);
+  }}
+
+  PetscCallThrow(VecRestoreArray(vec, &array));
+}
+
+DA::FieldView::~FieldView() noexcept(false) {
+  if (type != Read) {
+    WriteBack();
+  }
+}
+
 }
@@ -2,27 +2,61 @@
 #define SRC_DMDA_H
 
 #include <string_view>
+#include <vector>
 
 #include <petscdmda.h>
 
+#include "binary.h"
 #include "dm.h"
+#include "is.h"
 
 #include "exception.h"
 #include "utils.h"
+#include "mdview.h"
 
 namespace Petsc {
 
+/// @brief Iteration parameters of `DA::ForEachPoint()`, tiles are distributed among OpenMP threads
+struct Tiling {
+  Int3 tile = {64, 8, 8};
+  Bool threaded = PETSC_TRUE;
+  /// @brief Vectorizes innermost `i` loop, kernel should be free of dependencies along it
+  Bool simd = PETSC_FALSE;
+};
+
 class DA : public DM {
  public:
   using StencilType = DMDAStencilType;
 
+  /// @brief Box of grid points as `(corner, size)` pair, the same as returned by `GetCorners()`
+  using Box = std::pair<Int3, Int3>;
+
   DA(std::string_view name = {});
+  DA(MPI_Comm comm, std::string_view name = {});
   PETSC_DEFAULT_COPY_POLICY(DA);
 
   static DA Create();
+  static DA Create(MPI_Comm comm);
   static DA Create1d(BoundaryType boundary, Int global, Int dof, Int s, const Int* ranges);
+  static DA Create1d(MPI_Comm comm, BoundaryType boundary, Int global, Int dof, Int s, const Int* ranges);
   static DA Create2d(Two<BoundaryType> boundary, StencilType type, Int2 global, Int2 procs, Int dof, Int s, Two<const Int*> ranges);
+  static DA Create2d(MPI_Comm comm, Two<BoundaryType> boundary, StencilType type, Int2 global, Int2 procs, Int dof, Int s, Two<const Int*> ranges);
   static DA Create3d(Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs, Int dof, Int s, Three<const Int*> ranges);
+  static DA Create3d(MPI_Comm comm, Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs, Int dof, Int s, Three<const Int*> ranges);
+
+  /// @brief Same as `Create1d/2d/3d()` followed by `SetUp()`, but identical calls share one DMDA with
+  /// its ownership ranges, local-to-global mapping and ghost scatters, and calls that differ only
+  /// by `dof` share the partitioning. The cache is cleared by `PetscFinalize()`.
+  /// @note Shared DA are the same PETSc object, so names, options and composed objects are shared too
+  static DA CreateCached1d(BoundaryType boundary, Int global, Int dof, Int s, const Int* ranges);
+  static DA CreateCached1d(MPI_Comm comm, BoundaryType boundary, Int global, Int dof, Int s, const Int* ranges);
+  static DA CreateCached2d(Two<BoundaryType> boundary, StencilType type, Int2 global, Int2 procs, Int dof, Int s, Two<const Int*> ranges);
+  static DA CreateCached2d(MPI_Comm comm, Two<BoundaryType> boundary, StencilType type, Int2 global, Int2 procs, Int dof, Int s, Two<const Int*> ranges);
+  static DA CreateCached3d(Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs, Int dof, Int s, Three<const Int*> ranges);
+  static DA CreateCached3d(MPI_Comm comm, Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs, Int dof, Int s, Three<const Int*> ranges);
+
+  /// @brief Set up DA with the same layout and ownership ranges, but another number of degrees of freedom
+  DA CloneWithDof(Int dof) const;
 
   void SetSizes(Int3 global);
   Int3 GetSizes() const;
@@ -42,6 +76,42 @@ class DA : public DM {
   std::pair<Int3, Int3> GetCorners() const;
   std::pair<Int3, Int3> GetGhostCorners() const;
 
+  /// @brief Vector in the natural `(k, j, i, dof)` ordering, partitioned as the global one.
+  /// The scatter between the orderings is built on the first use and kept by the DMDA.
+  Vec CreateNaturalVector() const;
+  void GlobalToNatural(const Vec& global, InsertMode mode, Vec& natural) const;
+  void GlobalToNaturalBegin(const Vec& global, InsertMode mode, Vec& natural) const;
+  void GlobalToNaturalEnd(const Vec& global, InsertMode mode, Vec& natural) const;
+  void NaturalToGlobal(const Vec& natural, InsertMode mode, Vec& global) const;
+  void NaturalToGlobalBegin(const Vec& natural, InsertMode mode, Vec& global) const;
+  void NaturalToGlobalEnd(const Vec& natural, InsertMode mode, Vec& global) const;
+
+  /// @brief Extracts a box of the global vector as a parallel vector in the natural ordering of the
+  /// box, so it can be viewed or written directly. The scatter is cached on the DA per box.
+  /// @param component Single component to extract, or `PETSC_DECIDE` for all of them, interlaced
+  Vec GetNaturalSlice(const Vec& global, const Box& box, Int component = PETSC_DECIDE) const;
+
+#ifdef PETSC_HAVE_MPIIO
+  /// @brief Reads the box `[lo, hi)` of a vector of this DA saved by `Vec::View()` at the current MPI-IO
+  /// offset of `viewer`. Subarray file views select the box, so only its points are read from the file.
+  /// The result is a global vector of a new DA over the box, with one dof per requested component.
+  /// @param components Components to read in the given order, empty for all of them
+  /// @note The box is partitioned as any DA on the communicator of `viewer`, so it should not be too small
+  Vec LoadRegion(Binary& viewer, Int3 lo, Int3 hi, const std::vector<Int>& components = {}) const;
+  /// @brief Same as `LoadRegion()`, but each process reads the whole box into an array in the natural
+  /// `(k, j, i, component)` ordering of the box
+  std::vector<Scalar> LoadRegionLocal(Binary& viewer, Int3 lo, Int3 hi, const std::vector<Int>& components = {}) const;
+#endif
+
+  /// @brief Index sets of the owned part of a region in the PETSc global ordering, to be used with
+  /// `Vec::GetSubVector()`. Regions of whole owned rows and planes give `ISSTRIDE`, all components of
+  /// the other ones give `ISBLOCK`. Index sets are cached on the DA, so they should not be modified.
+  /// @param components Components to take in the given order, empty for all of them
+  IS BoxIS(Int3 lo, Int3 hi, const std::vector<Int>& components = {}) const;
+  /// @brief Plane `position` across the `axis` (0, 1, 2 for x, y, z), `PETSC_DECIDE` takes all components
+  IS SliceIS(Int axis, Int position, Int component = PETSC_DECIDE) const;
+  IS ComponentIS(Int component) const;
+
   void SetFieldName(Int nf, const char* name);
   const char* GetFieldName(Int nf) const;
   void SetFieldNames(const char** name);
@@ -49,10 +119,74 @@ class DA : public DM {
   void SetCoordinateName(Int nf, const char* name);
   const char* GetCoordinateName(Int nf) const;
 
+  /// @brief Index of the field named by `SetFieldName()`
+  Int GetFieldIndex(std::string_view name) const;
+  /// @brief Vector of one value per grid point, to be used with `Vec::StrideGather()`
+  Vec CreateFieldVector() const;
+
+  /// @brief Creates a DA with the same parameters, but with ownership ranges that equalize the
+  /// total `cost` of the processes along each axis of the process grid
+  /// @param cost Per-point cost, laid out as `CreateFieldVector()`
+  DA Balance(const Vec& cost) const;
+  /// @brief Cost that spreads the measured step time of the process evenly over its owned points
+  Vec CreateCostFromTime(Real stepTime) const;
+  /// @brief Moves the global vector `from` of this DA onto the global vector of the DA `to`,
+  /// which should have the same sizes and dof, like the one returned by `Balance()`
+  Vec Redistribute(const Vec& from, const DA& to) const;
+
+  /// @brief Calls `kernel(k, j, i)` for each owned point tile by tile, indices above dimension are zero
+  template<typename Kernel> void ForEachPoint(Kernel&& kernel, const Tiling& tiling = {}) const;
+  template<typename Kernel> static void ForEachPoint(const Box& box, Kernel&& kernel, const Tiling& tiling = {});
+
+  /// @brief Calls `interior(k, j, i)` on owned points which stencil stays inside of the physical
+  /// domain, so it needs no boundary checks, and `boundary(k, j, i)` on the rest of them
+  template<typename Interior, typename Boundary>
+  void StencilSweep(Interior&& interior, Boundary&& boundary, const Tiling& tiling = {}) const;
+
+  /// @brief Starts the ghost update of `local`, runs `kernel(u, k, j, i)` on the owned points that
+  /// do not depend on ghosts with `u` viewing `global`, then finishes the update and runs the
+  /// kernel on the remaining shell with `u` viewing `local`. Both views index by global indices.
+  template<Int Dim, Int Dof = 1, typename Kernel>
+  void Sweep(const Vec& global, Vec& local, Kernel&& kernel, const Tiling& tiling = {}) const;
+
+  /// @brief Advances `global` by `steps` applications of `kernel(in, out, k, j, i)` after a single
+  /// ghost update. Each step is computed redundantly on the ghost points that are still valid, so
+  /// the stencil width of the DA should be at least `steps * s`, where `s` is the kernel radius.
+  /// @note Points next to non-periodic boundaries have no ghosts, the kernel should check them itself
+  template<Int Dim, Int Dof = 1, typename Kernel>
+  void TemporalSweep(Vec& global, Int steps, Int s, Kernel&& kernel, const Tiling& tiling = {});
+
+  /// @brief Owned points whose stencil does not cross non-periodic boundaries of the grid
+  Box GetPhysicalInterior() const;
+  /// @brief Owned points whose stencil does not reach ghost points
+  Box GetGhostInterior() const;
+  /// @brief Ghost box shrunk by `width` on the sides that have ghost points
+  Box GetValidRegion(Int width) const;
+  /// @brief Splits the part of `outer` box not covered by `inner` one into disjoint slabs
+  static std::vector<Box> GetShell(const Box& outer, const Box& inner);
+
   /// @todo const correctness for borrowed arrays
   /// @todo guard type T with std::enable_if, T should be at least pointer
   template<typename T> class Borrowed;
   template<typename T> Borrowed<T> GetArray(Vec& vec, GetArrayType type = Default);
+
+  /// @brief Typed views with a flat layout, `Dof` can be `dynamicExtent`
+  template<Int Dim, Int Dof, bool isConst> class BorrowedView;
+  template<Int Dim, Int Dof = 1> BorrowedView<Dim, Dof, false> GetView(Vec& vec, GetArrayType type = Default) const;
+  template<Int Dim, Int Dof = 1> BorrowedView<Dim, Dof, true> GetView(const Vec& vec) const;
+
+  /// @brief Structure-of-arrays copies of the fields over a box of an interlaced vector
+  class FieldView;
+  FieldView GetFieldView(Vec& vec, GetArrayType type = Default) const;
+  FieldView GetFieldView(Vec& vec, const Box& box, GetArrayType type = Default) const;
+
+ private:
+  /// @brief Takes over a reference to a DMDA without creating one
+  DA(_p_DM* dm) { that = dm; }
+
+  /// @brief Looks up the layout, calls `create()` if it is met for the first time
+  template<typename Create>
+  static DA FromLayoutCache(MPI_Comm comm, std::vector<Int> layout, Int dof, Create&& create);
 };
 
 template<typename T>
@@ -73,6 +207,74 @@ class DA::Borrowed {
   T array;
 };
 
+/// @brief Field `f` of the point `(k, j, i)` is stored at `view[f][view.Offset(k, j, i)]`, so
+/// rows along `i` are contiguous. Unless viewed as `Read`, fields are written back on destruction.
+class DA::FieldView {
+ public:
+  /// @note `Write` type skips the initial transpose, fields start from zero and only the ones
+  /// accessed through the non-const accessors are written back
+  FieldView(const DA& da, Vec& vec, const Box& box, GetArrayType type);
+  ~FieldView() noexcept(false);
+  PETSC_NO_COPY_POLICY(FieldView);
+
+  Scalar* operator[](Int f) {
+    if (type == Write) {
+      selected[f] = true;
+    }
+    return fields.data() + f * points;
+  }
+  const Scalar* operator[](Int f) const { return fields.data() + f * points; }
+
+  /// @brief Field by the name set with `DA::SetFieldName()`
+  Scalar* Field(std::string_view name) { return (*this)[da.GetFieldIndex(name)]; }
+  const Scalar* Field(std::string_view name) const { return (*this)[da.GetFieldIndex(name)]; }
+
+  Int Offset(Int k, Int j, Int i) const {
+    return ((k - box.first.z) * box.second.y + (j - box.first.y)) * box.second.x + (i - box.first.x);
+  }
+
+  Int GetNumFields() const { return dof; }
+  Int GetNumPoints() const { return points; }
+  const Box& GetBox() const { return box; }
+
+  /// @brief Transposes the fields back into the interlaced vector
+  void WriteBack();
+
+ private:
+  const DA& da;
+  Vec& vec;
+  GetArrayType type;
+
+  Box box;
+  Int dof;
+  Int points;
+
+  /// @brief Corner and size of the vector array, ghosted for local vectors
+  Int3 arrayCorner;
+  Int3 arraySize;
+
+  std::vector<Scalar> fields;
+  /// @brief Fields accessed by a `Write` view
+  std::vector<char> selected;
+};
+
+template<Int Dim, Int Dof, bool isConst>
+class DA::BorrowedView : public MDView<std::conditional_t<isConst, const Scalar, Scalar>, Dim, Dof> {
+  using VecRef = std::conditional_t<isConst, const Vec&, Vec&>;
+  using Array = std::conditional_t<isConst, Vec::ConstBorrowedArray, Vec::BorrowedArray>;
+
+ public:
+  /// @brief Local vectors are viewed with ghost corners, global vectors with owned ones
+  BorrowedView(const DA& da, VecRef vec, GetArrayType type);
+  /// @brief Same with the corners and the number of components known to the caller, nothing is queried
+  BorrowedView(const Box& owned, const Box& ghosted, Int dof, VecRef vec, GetArrayType type);
+  ~BorrowedView() = default;
+  PETSC_NO_COPY_POLICY(BorrowedView);
+
+ private:
+  Array array;
+};
+
 }
 
 #include "dmda.inl"
@@ -1,5 +1,7 @@
 #include "dmda.h"
 
+#include <algorithm>
+
 namespace Petsc {
 
 template<typename T>
@@ -7,6 +9,159 @@ DA::Borrowed<T> DA::GetArray(Vec& vec, GetArrayType type) {
   return Borrowed<T>(*this, vec, type);
 }
 
+template<typename Kernel>
+void DA::ForEachPoint(Kernel&& kernel, const Tiling& tiling) const {
+  ForEachPoint(GetCorners(), kernel, tiling);
+}
+
+template<typename Kernel>
+/* static */ void DA::ForEachPoint(const Box& box, Kernel&& kernel, const Tiling& tiling) {
+  const Int3& start = box.first;
+  const Int3& size = box.second;
+  if (size.x <= 0 || size.y <= 0 || size.z <= 0) {
+    return;
+  }
+
+  Int3 tile(
+    std::clamp<Int>(tiling.tile.x, 1, size.x),
+    std::clamp<Int>(tiling.tile.y, 1, size.y),
+    std::clamp<Int>(tiling.tile.z, 1, size.z));
+
+  Int3 count(
+    (size.x + tile.x - 1) / tile.x,
+    (size.y + tile.y - 1) / tile.y,
+    (size.z + tile.z - 1) / tile.z);
+
+  Int tiles = count.x * count.y * count.z;
+
+  #pragma omp parallel for schedule(static) if (tiling.threaded && tiles > 1)
+  for (Int t = 0; t < tiles; ++t) {
+    Int3 lo(
+      start.x + (t % count.x) * tile.x,
+      start.y + (t / count.x % count.y) * tile.y,
+      start.z + (t / (count.x * count.y)) * tile.z);
+
+    Int3 hi(
+      std::min(lo.x + tile.x, start.x + size.x),
+      std::min(lo.y + tile.y, start.y + size.y),
+      std::min(lo.z + tile.z, start.z + size.z));
+
+    for (Int k = lo.z; k < hi.z; ++k) {
+    for (Int j = lo.y; j < hi.y; ++j) {
+      if (tiling.simd) {
+        #pragma omp simd
+        for (Int i = lo.x; i < hi.x; ++i) {
+          kernel(k, j, i);
+        }
+      }
+      else {
+        for (Int i = lo.x; i < hi.x; ++i) {
+          kernel(k, j, i);
+        }
+      }
+    }}
+  }
+}
+
+template<typename Interior, typename Boundary>
+void DA::StencilSweep(Interior&& interior, Boundary&& boundary, const Tiling& tiling) const {
+  Box owned = GetCorners();
+  Box inner = GetPhysicalInterior();
+
+  ForEachPoint(inner, interior, tiling);
+  for (const Box& slab : GetShell(owned, inner)) {
+    ForEachPoint(slab, boundary, tiling);
+  }
+}
+
+template<Int Dim, Int Dof, typename Kernel>
+void DA::Sweep(const Vec& global, Vec& local, Kernel&& kernel, const Tiling& tiling) const {
+  Box owned = GetCorners();
+  Box inner = GetGhostInterior();
+
+  GlobalToLocalBegin(global, INSERT_VALUES, local);
+  {
+    auto u = GetView<Dim, Dof>(global);
+    ForEachPoint(inner, [&](Int k, Int j, Int i) { kernel(u, k, j, i); }, tiling);
+  }
+  GlobalToLocalEnd(global, INSERT_VALUES, local);
+
+  auto u = GetView<Dim, Dof>(static_cast<const Vec&>(local));
+  for (const Box& slab : GetShell(owned, inner)) {
+    ForEachPoint(slab, [&](Int k, Int j, Int i) { kernel(u, k, j, i); }, tiling);
+  }
+}
+
+template<Int Dim, Int Dof, typename Kernel>
+void DA::TemporalSweep(Vec& global, Int steps, Int s, Kernel&& kernel, const Tiling& tiling) {
+  if (steps * s > GetStencilWidth()) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+  // Star stencils do not update the diagonal ghost points the later steps depend on
+  if (steps > 1 && GetStencilType() != DMDA_STENCIL_BOX) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+
+  auto first = GetVector(Local);
+  auto second = GetVector(Local);
+  Vec* in = &static_cast<Vec&>(first);
+  Vec* out = &static_cast<Vec&>(second);
+
+  GlobalToLocal(global, INSERT_VALUES, *in);
+  for (Int t = 0; t < steps; ++t) {
+    {
+      auto u = GetView<Dim, Dof>(static_cast<const Vec&>(*in));
+      auto v = GetView<Dim, Dof>(*out);
+      ForEachPoint(GetValidRegion((t + 1) * s), [&](Int k, Int j, Int i) { kernel(u, v, k, j, i); }, tiling);
+    }
+    std::swap(in, out);
+  }
+  LocalToGlobal(*in, INSERT_VALUES, global);
+}
+
+template<Int Dim, Int Dof>
+DA::BorrowedView<Dim, Dof, false> DA::GetView(Vec& vec, GetArrayType type) const {
+  if (!(type == Default || type == Write)) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+  return BorrowedView<Dim, Dof, false>(*this, vec, type);
+}
+
+template<Int Dim, Int Dof>
+DA::BorrowedView<Dim, Dof, true> DA::GetView(const Vec& vec) const {
+  return BorrowedView<Dim, Dof, true>(*this, vec, Read);
+}
+
+template<Int Dim, Int Dof, bool isConst>
+DA::BorrowedView<Dim, Dof, isConst>::BorrowedView(const DA& da, VecRef vec, GetArrayType type)
+    : BorrowedView(da.GetCorners(), da.GetGhostCorners(), da.GetDof(), vec, type) {
+  if (da.GetDimension() != Dim) {
+    PetscCallThrow(PETSC_ERR_ARG_INCOMP);
+  }
+}
+
+template<Int Dim, Int Dof, bool isConst>
+DA::BorrowedView<Dim, Dof, isConst>::BorrowedView(const Box& owned, const Box& ghosted, Int dof, VecRef vec, GetArrayType type)
+    : array(vec, type) {
+  if (Dof != dynamicExtent && dof != Dof) {
+    PetscCallThrow(PETSC_ERR_ARG_INCOMP);
+  }
+
+  auto [corner, size] = owned;
+  auto [ghostCorner, ghostSize] = ghosted;
+
+  Int localSize = vec.GetLocalSize();
+  if (localSize == ghostSize.x * ghostSize.y * ghostSize.z * dof) {
+    this->Reset(array, ghostCorner, ghostSize, dof);
+  }
+  else if (localSize == size.x * size.y * size.z * dof) {
+    this->Reset(array, corner, size, dof);
+  }
+  else {
+    PetscCallThrow(PETSC_ERR_ARG_SIZ);
+  }
+}
+
 template<typename T>
 DA::Borrowed<T>::Borrowed(DA& da, Vec& vec, GetArrayType type)
     : da(da), vec(vec), type(type) {
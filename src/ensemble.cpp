@@ -0,0 +1,78 @@
+#include "ensemble.h"
+
+namespace Petsc {
+
+Ensemble::Ensemble(MPI_Comm comm, Int groups) {
+  PetscCallThrow(PetscSubcommCreate(comm, &subcomm));
+  PetscCallThrow(PetscSubcommSetNumber(subcomm, groups));
+  PetscCallThrow(PetscSubcommSetType(subcomm, PETSC_SUBCOMM_CONTIGUOUS));
+
+  MPIInt rank;
+  PetscCallMPIThrow(MPI_Comm_rank(GetComm(), &rank));
+  PetscCallMPIThrow(MPI_Comm_split(comm, rank == 0 ? 0 : MPI_UNDEFINED, GetGroup(), &roots));
+}
+
+MPI_Comm Ensemble::GetComm() const {
+  return PetscSubcommChild(subcomm);
+}
+
+Int Ensemble::GetGroup() const {
+  return subcomm->color;
+}
+
+Int Ensemble::GetNumGroups() const {
+  return subcomm->n;
+}
+
+std::pair<Int, Int> Ensemble::GetMembers(Int members) const {
+  return GetMembers(members, GetGroup());
+}
+
+std::pair<Int, Int> Ensemble::GetMembers(Int members, Int group) const {
+  Int groups = GetNumGroups();
+  return std::make_pair(group * members / groups, (group + 1) * members / groups);
+}
+
+std::vector<Scalar> Ensemble::Gather(Int members, Int count, const std::vector<Scalar>& local) const {
+  std::vector<Scalar> result;
+  if (roots == MPI_COMM_NULL) {
+    return result;
+  }
+
+  auto [first, last] = GetMembers(members);
+  if ((Int)local.size() != (last - first) * count) {
+    PetscCallThrow(PETSC_ERR_ARG_SIZ);
+  }
+
+  // Groups hold contiguous ranges of members, so the values are placed by a single gather
+  Int groups = GetNumGroups();
+  std::vector<MPIInt> counts(groups), displs(groups);
+  for (Int g = 0; g < groups; ++g) {
+    auto [begin, end] = GetMembers(members, g);
+    counts[g] = (MPIInt)((end - begin) * count);
+    displs[g] = (MPIInt)(begin * count);
+  }
+
+  MPIInt rank;
+  PetscCallMPIThrow(MPI_Comm_rank(roots, &rank));
+  if (rank == 0) {
+    result.resize(members * count);
+  }
+
+  PetscCallMPIThrow(MPI_Gatherv(local.data(), counts[rank], MPIU_SCALAR,
+    result.data(), counts.data(), displs.data(), MPIU_SCALAR, 0, roots));
+  return result;
+}
+
+void Ensemble::Destroy() {
+  if (roots != MPI_COMM_NULL) {
+    PetscCallMPIThrow(MPI_Comm_free(&roots));
+  }
+  PetscCallThrow(PetscSubcommDestroy(&subcomm));
+}
+
+Ensemble::~Ensemble() noexcept(false) {
+  Destroy();
+}
+
+}
@@ -0,0 +1,52 @@
+#ifndef SRC_ENSEMBLE_H
+#define SRC_ENSEMBLE_H
+
+#include <vector>
+
+#include <petscsys.h>
+
+#include "exception.h"
+#include "utils.h"
+
+namespace Petsc {
+
+/// @brief Splits the communicator into contiguous groups of processes,
+/// each group runs its own share of independent ensemble members.
+class Ensemble {
+ public:
+  Ensemble(MPI_Comm comm, Int groups);
+  PETSC_NO_COPY_POLICY(Ensemble);
+
+  /// @brief Sub-communicator of the group this process belongs to
+  MPI_Comm GetComm() const;
+  Int GetGroup() const;
+  Int GetNumGroups() const;
+
+  /// @brief Range of members `[first, last)` assigned to the group
+  std::pair<Int, Int> GetMembers(Int members) const;
+  std::pair<Int, Int> GetMembers(Int members, Int group) const;
+
+  /// @brief Calls `pipeline(member, comm)` for each member assigned to this group
+  template<typename Pipeline>
+  void Run(Int members, Pipeline&& pipeline) const;
+
+  /// @brief Collects `count` values per member from the group roots to the root of the parent communicator
+  /// @param local Values of the members assigned to this group, in order, significant on the group root only
+  /// @returns `members * count` values ordered by member on the parent root, empty elsewhere
+  std::vector<Scalar> Gather(Int members, Int count, const std::vector<Scalar>& local) const;
+
+  void Destroy();
+  ~Ensemble() noexcept(false);
+
+ private:
+  PetscSubcomm subcomm = nullptr;
+
+  /// @brief Roots of the groups ordered by the group index, null on the other processes
+  MPI_Comm roots = MPI_COMM_NULL;
+};
+
+}
+
+#include "ensemble.inl"
+
+#endif // SRC_ENSEMBLE_H
@@ -0,0 +1,13 @@
+#include "ensemble.h"
+
+namespace Petsc {
+
+template<typename Pipeline>
+void Ensemble::Run(Int members, Pipeline&& pipeline) const {
+  auto [first, last] = GetMembers(members);
+  for (Int member = first; member < last; ++member) {
+    pipeline(member, GetComm());
+  }
+}
+
+}
@@ -34,4 +34,17 @@ class Exception : public std::runtime_error {
     }                                                        \
   } while (0)
 
+#define PetscCallMPIThrow(...)                               \
+  do {                                                       \
+    PetscStackUpdateLine;                                    \
+    PetscMPIInt ierr_mpi_call_ = __VA_ARGS__;                \
+    if (PetscUnlikely(ierr_mpi_call_ != MPI_SUCCESS)) {      \
+      std::stringstream msg;                                 \
+      msg << "MPI ERROR: "                                   \
+          << PETSC_FUNCTION_NAME_CXX << "() "                \
+          << "at " << __FILE__ << ":" << __LINE__ << "\n";   \
+      throw Petsc::Exception(msg.str(), PETSC_ERR_MPI);      \
+    }                                                        \
+  } while (0)
+
 #endif // SRC_MACROS_H
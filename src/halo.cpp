@@ -0,0 +1,186 @@
+#include "halo.h"
+
+#include <algorithm>
+
+namespace Petsc {
+
+namespace {
+
+/// @brief Range `[first, first + size)` along the axis for the offset `d` to the neighbor
+void GetRange(Int d, bool send, Int s, Int corner, Int size, Int ghostCorner, Int ghostSize, Int& first, Int& count) {
+  if (d == 0) {
+    first = corner;
+    count = size;
+  }
+  else if (d < 0) {
+    first = send ? corner : ghostCorner;
+    count = send ? s : corner - ghostCorner;
+  }
+  else {
+    first = send ? corner + size - s : corner + size;
+    count = send ? s : ghostCorner + ghostSize - corner - size;
+  }
+}
+
+MPI_Datatype CreateRegionType(Int3 d, bool send, Int s, Int dof, Int3 corner, Int3 size, Int3 ghostCorner, Int3 ghostSize) {
+  Int3 first, count;
+  GetRange(d.x, send, s, corner.x, size.x, ghostCorner.x, ghostSize.x, first.x, count.x);
+  GetRange(d.y, send, s, corner.y, size.y, ghostCorner.y, ghostSize.y, first.y, count.y);
+  GetRange(d.z, send, s, corner.z, size.z, ghostCorner.z, ghostSize.z, first.z, count.z);
+
+  MPIInt sizes[4] = {(MPIInt)ghostSize.z, (MPIInt)ghostSize.y, (MPIInt)ghostSize.x, (MPIInt)dof};
+  MPIInt subsizes[4] = {(MPIInt)count.z, (MPIInt)count.y, (MPIInt)count.x, (MPIInt)dof};
+  MPIInt starts[4] = {
+    (MPIInt)(first.z - ghostCorner.z),
+    (MPIInt)(first.y - ghostCorner.y),
+    (MPIInt)(first.x - ghostCorner.x),
+    0,
+  };
+
+  MPI_Datatype type;
+  PetscCallMPIThrow(MPI_Type_create_subarray(4, sizes, subsizes, starts, MPI_ORDER_C, MPIU_SCALAR, &type));
+  PetscCallMPIThrow(MPI_Type_commit(&type));
+  return type;
+}
+
+}
+
+HaloExchange::HaloExchange(const DA& da) {
+  PetscCallMPIThrow(MPI_Comm_dup(PetscObjectComm(da), &comm));
+
+  auto [corner, size] = da.GetCorners();
+  auto [ghostCorner, ghostSize] = da.GetGhostCorners();
+  Int dim = da.GetDimension();
+  Int s = da.GetStencilWidth();
+  bool star = da.GetStencilType() == DMDA_STENCIL_STAR;
+
+  start = {corner.x - ghostCorner.x, corner.y - ghostCorner.y, corner.z - ghostCorner.z};
+  owned = size;
+  ghosted = ghostSize;
+  dof = da.GetDof();
+
+  // Neighbors are ordered as `(dz + 1) * 9 + (dy + 1) * 3 + (dx + 1)`, negative if absent
+  auto [n, neighbors] = da.GetNeighbors();
+  Int rz = dim > 2 ? 1 : 0;
+  Int ry = dim > 1 ? 1 : 0;
+
+  for (Int dz = -rz; dz <= rz; ++dz) {
+  for (Int dy = -ry; dy <= ry; ++dy) {
+  for (Int dx = -1; dx <= 1; ++dx) {
+    Int nonzero = (dx != 0) + (dy != 0) + (dz != 0);
+    if (nonzero == 0 || (star && nonzero > 1)) {
+      continue;
+    }
+
+    Int index = (dz + rz) * 9 + (dy + ry) * 3 + (dx + 1);
+    Int opposite = (rz - dz) * 9 + (ry - dy) * 3 + (1 - dx);
+    if (index >= n || neighbors[index] < 0) {
+      continue;
+    }
+
+    // The neighbor sends its region towards us under the tag of its own direction
+    Int3 d = {dx, dy, dz};
+    sends.emplace_back(Message{neighbors[index], (MPIInt)index, CreateRegionType(d, true, s, dof, corner, size, ghostCorner, ghostSize)});
+    receives.emplace_back(Message{neighbors[index], (MPIInt)opposite, CreateRegionType(d, false, s, dof, corner, size, ghostCorner, ghostSize)});
+  }}}
+
+  requests.assign(sends.size() + receives.size(), MPI_REQUEST_NULL);
+}
+
+void HaloExchange::Bind(Scalar* data) {
+  if (data == bound) {
+    return;
+  }
+  for (auto& request : requests) {
+    if (request != MPI_REQUEST_NULL) {
+      PetscCallMPIThrow(MPI_Request_free(&request));
+    }
+  }
+
+  // Receives are posted first, so that `MPI_Startall()` does not delay the matching
+  std::size_t r = 0;
+  for (const auto& m : receives) {
+    PetscCallMPIThrow(MPI_Recv_init(data, 1, m.type, m.rank, m.tag, comm, &requests[r++]));
+  }
+  for (const auto& m : sends) {
+    PetscCallMPIThrow(MPI_Send_init(data, 1, m.type, m.rank, m.tag, comm, &requests[r++]));
+  }
+  bound = data;
+}
+
+void HaloExchange::Begin(Vec& local) {
+  if (array) {
+    PetscCallThrow(PETSC_ERR_ORDER);
+  }
+  PetscCallThrow(VecGetArray(local, &array));
+  Bind(array);
+
+  if (!requests.empty()) {
+    PetscCallMPIThrow(MPI_Startall((MPIInt)requests.size(), requests.data()));
+  }
+}
+
+void HaloExchange::End(Vec& local) {
+  if (!array) {
+    PetscCallThrow(PETSC_ERR_ORDER);
+  }
+  if (!requests.empty()) {
+    PetscCallMPIThrow(MPI_Waitall((MPIInt)requests.size(), requests.data(), MPI_STATUSES_IGNORE));
+  }
+  PetscCallThrow(VecRestoreArray(local, &array));
+  array = nullptr;
+}
+
+void HaloExchange::Exchange(Vec& local) {
+  Begin(local);
+  End(local);
+}
+
+void HaloExchange::GlobalToLocal(const Vec& global, Vec& local) {
+  const Scalar* src;
+  Scalar* dst;
+  PetscCallThrow(VecGetArrayRead(global, &src));
+  PetscCallThrow(VecGetArray(local, &dst));
+
+  Int row = owned.x * dof;
+  for (Int k = 0; k < owned.z; ++k) {
+  for (Int j = 0; j < owned.y; ++j) {
+    const Scalar* from = src + (k * owned.y + j) * row;
+    Scalar* to = dst + (((start.z + k) * ghosted.y + start.y + j) * ghosted.x + start.x) * dof;
+    std::copy(from, from + row, to);
+  }}
+
+  PetscCallThrow(VecRestoreArray(local, &dst));
+  PetscCallThrow(VecRestoreArrayRead(global, &src));
+  Exchange(local);
+}
+
+Int HaloExchange::GetNumNeighbors() const {
+  return (Int)sends.size();
+}
+
+void HaloExchange::Destroy() {
+  for (auto& request : requests) {
+    if (request != MPI_REQUEST_NULL) {
+      PetscCallMPIThrow(MPI_Request_free(&request));
+    }
+  }
+  for (auto* messages : {&sends, &receives}) {
+    for (auto& m : *messages) {
+      PetscCallMPIThrow(MPI_Type_free(&m.type));
+    }
+    messages->clear();
+  }
+  requests.clear();
+  bound = nullptr;
+
+  if (comm != MPI_COMM_NULL) {
+    PetscCallMPIThrow(MPI_Comm_free(&comm));
+  }
+}
+
+HaloExchange::~HaloExchange() noexcept(false) {
+  Destroy();
+}
+
+}
@@ -0,0 +1,63 @@
+#ifndef SRC_HALO_H
+#define SRC_HALO_H
+
+#include <vector>
+
+#include <petscdmda.h>
+
+#include "exception.h"
+#include "utils.h"
+#include "vec.h"
+#include "dmda.h"
+
+namespace Petsc {
+
+/// @brief Ghost update of the local vectors of a fixed `DA` decomposition. Face, edge and corner
+/// regions are described by derived datatypes over the local array and exchanged by persistent
+/// requests, so repeated exchanges send straight out of the vector and skip any setup.
+class HaloExchange {
+ public:
+  HaloExchange(const DA& da);
+  PETSC_NO_COPY_POLICY(HaloExchange);
+
+  /// @brief Starts the exchange of the ghost points of `local`, the array stays borrowed until `End()`
+  void Begin(Vec& local);
+  void End(Vec& local);
+  void Exchange(Vec& local);
+
+  /// @brief Copies the owned points of `global` into `local` and exchanges its ghosts
+  void GlobalToLocal(const Vec& global, Vec& local);
+
+  Int GetNumNeighbors() const;
+
+  void Destroy();
+  ~HaloExchange() noexcept(false);
+
+ private:
+  /// @brief Recreates the persistent requests when the local array has moved
+  void Bind(Scalar* data);
+
+  struct Message {
+    MPIInt rank;
+    MPIInt tag;
+    MPI_Datatype type;
+  };
+
+  MPI_Comm comm = MPI_COMM_NULL;
+  std::vector<Message> sends;
+  std::vector<Message> receives;
+  std::vector<MPI_Request> requests;
+
+  Scalar* bound = nullptr;
+  Scalar* array = nullptr;
+
+  /// @brief Owned box relative to the ghost corner, ghosted sizes, used by `GlobalToLocal()`
+  Int3 start;
+  Int3 owned;
+  Int3 ghosted;
+  Int dof;
+};
+
+}
+
+#endif // SRC_HALO_H
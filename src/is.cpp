@@ -1,7 +1,122 @@
 #include "is.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 namespace Petsc {
 
+namespace {
+
+struct Encoding {
+  ISType type;
+  Int step;
+  Int blockSize;
+};
+
+/// @brief Finds the smallest representation of `idx` that fits the indices of all processes
+Encoding Detect(MPI_Comm comm, std::span<const Int> idx) {
+  Int n = (Int)idx.size();
+
+  Int step = n > 1 ? idx[1] - idx[0] : 1;
+  Int stride = 1;
+  for (Int i = 2; i < n; ++i) {
+    if (idx[i] - idx[i - 1] != step) {
+      stride = 0;
+      break;
+    }
+  }
+
+  // Blocks should tile each run of consecutive indices and start at the multiple of the block size
+  Int blockSize = 0;
+  for (Int i = 0; i < n;) {
+    Int j = i + 1;
+    while (j < n && idx[j] == idx[j - 1] + 1) {
+      ++j;
+    }
+    blockSize = std::gcd(blockSize, std::gcd(j - i, idx[i]));
+    i = j;
+  }
+
+  MPIInt size;
+  PetscCallMPIThrow(MPI_Comm_size(comm, &size));
+
+  Int local[2] = {stride, blockSize};
+  std::vector<Int> all(2 * size);
+  PetscCallMPIThrow(MPI_Allgather(local, 2, MPIU_INT, all.data(), 2, MPIU_INT, comm));
+
+  for (MPIInt r = 0; r < size; ++r) {
+    stride = stride && all[2 * r];
+    blockSize = std::gcd(blockSize, all[2 * r + 1]);
+  }
+
+  if (stride) {
+    return Encoding{ISSTRIDE, step, 1};
+  }
+  if (blockSize > 1) {
+    return Encoding{ISBLOCK, 1, blockSize};
+  }
+  return Encoding{ISGENERAL, 1, 1};
+}
+
+void CreateEncoded(MPI_Comm comm, std::span<const Int> idx, const Encoding& encoding, _p_IS** is) {
+  Int n = (Int)idx.size();
+  if (encoding.type == ISSTRIDE) {
+    PetscCallThrow(ISCreateStride(comm, n, n > 0 ? idx[0] : 0, encoding.step, is));
+  }
+  else if (encoding.type == ISBLOCK) {
+    std::vector<Int> blocks;
+    blocks.reserve(n / encoding.blockSize);
+    for (Int i = 0; i < n; i += encoding.blockSize) {
+      blocks.emplace_back(idx[i] / encoding.blockSize);
+    }
+    PetscCallThrow(ISCreateBlock(comm, encoding.blockSize, (Int)blocks.size(), blocks.data(), PETSC_COPY_VALUES, is));
+  }
+  else {
+    PetscCallThrow(ISCreateGeneral(comm, n, idx.data(), PETSC_COPY_VALUES, is));
+  }
+}
+
+/// @brief Local range `[first, last)` of the unit-step stride index set
+bool GetRange(const IS& is, Int& first, Int& last) {
+  PetscBool stride;
+  PetscCallThrow(PetscObjectTypeCompare(is, ISSTRIDE, &stride));
+  if (!stride) {
+    return false;
+  }
+  Int step, n = is.GetLocalSize();
+  PetscCallThrow(ISStrideGetInfo(is, &first, &step));
+  if (n > 1 && step != 1) {
+    return false;
+  }
+  last = first + n;
+  return true;
+}
+
+/// @brief Combines the ranges of `a` and `b` by `range()` if it succeeds on all processes,
+/// falls back to the PETSc set operation `op` otherwise
+template<typename Range, typename Op>
+IS Combine(const IS& a, const IS& b, Range&& range, Op op) {
+  MPI_Comm comm = PetscObjectComm(a);
+
+  Int first = 0, last = 0, aFirst, aLast, bFirst, bLast;
+  int ok = GetRange(a, aFirst, aLast) && GetRange(b, bFirst, bLast) &&
+    range(aFirst, aLast, bFirst, bLast, first, last);
+  PetscCallMPIThrow(MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_LAND, comm));
+
+  IS is;
+  if (ok) {
+    PetscCallThrow(ISCreateStride(comm, last - first, first, 1, is));
+  }
+  else {
+    PetscCallThrow(op(a, b, is));
+    is.Compress();
+  }
+  return is;
+}
+
+}
+
 IS::IS(MPI_Comm comm, std::string_view name) {
   PetscCallThrow(ISCreate(comm, &that));
   if (!name.empty()) {
@@ -32,6 +147,82 @@ IS::IS(MPI_Comm comm, std::string_view name) {
   return is;
 }
 
+/* static */ IS IS::FromIndices(MPI_Comm comm, std::span<const Int> idx, Bool autoCompress) {
+  IS is;
+  if (autoCompress) {
+    CreateEncoded(comm, idx, Detect(comm, idx), is);
+  }
+  else {
+    PetscCallThrow(ISCreateGeneral(comm, (Int)idx.size(), idx.data(), PETSC_COPY_VALUES, is));
+  }
+  return is;
+}
+
+void IS::Compress() {
+  PetscBool general;
+  PetscCallThrow(PetscObjectTypeCompare(*this, ISGENERAL, &general));
+  if (!general) {
+    return;
+  }
+
+  MPI_Comm comm = PetscObjectComm(*this);
+  const Int* idx;
+  PetscCallThrow(ISGetIndices(that, &idx));
+  std::span<const Int> indices(idx, GetLocalSize());
+
+  auto encoding = Detect(comm, indices);
+  _p_IS* compressed = nullptr;
+  if (encoding.type != ISGENERAL) {
+    CreateEncoded(comm, indices, encoding, &compressed);
+  }
+  PetscCallThrow(ISRestoreIndices(that, &idx));
+
+  if (compressed) {
+    PetscCallThrow(ISDestroy(&that));
+    that = compressed;
+  }
+}
+
+/* static */ IS IS::Sum(const IS& a, const IS& b) {
+  return Combine(a, b, [](Int a0, Int a1, Int b0, Int b1, Int& first, Int& last) {
+    if (a0 == a1 || b0 == b1) {
+      first = a0 == a1 ? b0 : a0;
+      last = a0 == a1 ? b1 : a1;
+      return true;
+    }
+    first = std::min(a0, b0);
+    last = std::max(a1, b1);
+    return a0 <= b1 && b0 <= a1;
+  }, ISExpand);
+}
+
+/* static */ IS IS::Difference(const IS& a, const IS& b) {
+  return Combine(a, b, [](Int a0, Int a1, Int b0, Int b1, Int& first, Int& last) {
+    first = a0;
+    last = a1;
+    if (b0 == b1 || b1 <= a0 || a1 <= b0) {
+      return true;
+    }
+    if (b0 <= a0) {
+      first = std::min(b1, a1);
+      return true;
+    }
+    if (a1 <= b1) {
+      last = b0;
+      return true;
+    }
+    return false;
+  }, ISDifference);
+}
+
+/* static */ IS IS::Intersect(const IS& a, const IS& b) {
+  return Combine(a, b, [](Int a0, Int a1, Int b0, Int b1, Int& first, Int& last) {
+    first = std::max(a0, b0);
+    last = std::max(first, std::min(a1, b1));
+    return true;
+  }, ISIntersect);
+}
+
 IS IS::Duplicate() const {
   IS is;
   PetscCallThrow(ISDuplicate(that, is));
@@ -61,14 +252,8 @@ void IS::BlockSetIndices(Int blockSize, Int blocksNumber, const Int idx[], CopyM
   PetscCallThrow(ISBlockSetIndices(that, blockSize, blocksNumber, idx, mode));
 }
 
-const Int* IS::GetIndices() {
-  const Int* idx;
-  PetscCallThrow(ISGetIndices(that, &idx));
-  return idx;
-}
-
-void IS::RestoreIndices(const Int* idx[]) {
-  PetscCallThrow(ISRestoreIndices(that, idx));
+IS::BorrowedIndices IS::GetIndices() const {
+  return BorrowedIndices(*this);
 }
 
 Int IS::GetLocalSize() const {
@@ -95,4 +280,63 @@ IS::~IS() noexcept(false) {
   Destroy();
 }
 
+
+IS::BorrowedIndices::BorrowedIndices(const IS& is)
+    : is(is), n(is.GetLocalSize()) {
+  PetscBool match;
+  PetscCallThrow(PetscObjectTypeCompare(is, ISSTRIDE, &match));
+  if (match) {
+    kind = Stride;
+    PetscCallThrow(ISStrideGetInfo(is, &first, &step));
+    return;
+  }
+
+  PetscCallThrow(PetscObjectTypeCompare(is, ISBLOCK, &match));
+  if (match) {
+    kind = Block;
+    PetscCallThrow(ISGetBlockSize(is, &blockSize));
+    PetscCallThrow(ISBlockGetIndices(is, &indices));
+    return;
+  }
+
+  kind = General;
+  PetscCallThrow(ISGetIndices(is, &indices));
+}
+
+std::span<const Int> IS::BorrowedIndices::span() {
+  if (kind == General) {
+    return std::span<const Int>(indices, n);
+  }
+  if (!expanded) {
+    PetscCallThrow(ISGetIndices(is, &expanded));
+  }
+  return std::span<const Int>(expanded, n);
+}
+
+IS::BorrowedIndices::Iterator IS::BorrowedIndices::begin() const {
+  return Iterator(*this, 0);
+}
+
+IS::BorrowedIndices::Iterator IS::BorrowedIndices::end() const {
+  return Iterator(*this, n);
+}
+
+void IS::BorrowedIndices::Restore() {
+  if (expanded) {
+    PetscCallThrow(ISRestoreIndices(is, &expanded));
+  }
+  if (indices && kind == Block) {
+    PetscCallThrow(ISBlockRestoreIndices(is, &indices));
+  }
+  if (indices && kind == General) {
+    PetscCallThrow(ISRestoreIndices(is, &indices));
+  }
+  expanded = nullptr;
+  indices = nullptr;
+}
+
+IS::BorrowedIndices::~BorrowedIndices() noexcept(false) {
+  Restore();
+}
+
 }
@@ -1,6 +1,7 @@
 #ifndef SRC_IS_H
 #define SRC_IS_H
 
+#include <span>
 #include <string_view>
 
 #include <petscis.h>
@@ -10,8 +11,6 @@
 
 namespace Petsc {
 
-/// @todo Generalize borrowing concept on different types, @see GetIndices.
-
 class IS {
  public:
   IS() = default;
@@ -23,6 +22,19 @@ class IS {
   static IS CreateStride(MPI_Comm comm, Int size, Int start, Int step);
   static IS CreateBlock(MPI_Comm comm, Int blockSize, Int blocksNumber, const Int idx[], CopyMode mode);
 
+  /// @brief Copies the indices, with `autoCompress` stores them as stride or block index set if they
+  /// form one on every process, contiguous runs are block index set of the greatest common block size
+  static IS FromIndices(MPI_Comm comm, std::span<const Int> idx, Bool autoCompress = PETSC_TRUE);
+
+  /// @brief Replaces general indices with stride or block ones, as `FromIndices()` does, collective
+  void Compress();
+
+  /// @brief Local union, difference and intersection of the index sets. Unit-step stride sets are
+  /// combined as ranges, the other ones by `ISExpand()`, `ISDifference()`, `ISIntersect()` and compressed.
+  static IS Sum(const IS& a, const IS& b);
+  static IS Difference(const IS& a, const IS& b);
+  static IS Intersect(const IS& a, const IS& b);
+
   IS Duplicate() const;
   IS Copy() const;
 
@@ -31,8 +43,8 @@ class IS {
   void StrideSetStride(Int size, Int start, Int step);
   void BlockSetIndices(Int blockSize, Int blocksNumber, const Int idx[], CopyMode mode);
 
-  const Int* GetIndices();
-  void RestoreIndices(const Int* idx[]);
+  class BorrowedIndices;
+  BorrowedIndices GetIndices() const;
 
   Int GetLocalSize() const;
   Int GetSize() const;
@@ -52,6 +64,76 @@ class IS {
   _p_IS* that = nullptr;
 };
 
+
+/// @brief Local indices borrowed until destruction or `Restore()`. Stride and block index sets are
+/// indexed and iterated on the fly, the expanded array is only made if `span()` is requested.
+class IS::BorrowedIndices {
+ public:
+  BorrowedIndices(const IS& is);
+  PETSC_NO_COPY_POLICY(BorrowedIndices);
+
+  void Restore();
+  ~BorrowedIndices() noexcept(false);
+
+  std::span<const Int> span();
+  Int size() const { return n; }
+
+  Int operator[](Int i) const {
+    switch (kind) {
+      case Stride: return first + i * step;
+      case Block: return indices[i / blockSize] * blockSize + i % blockSize;
+      default: return indices[i];
+    }
+  }
+
+  class Iterator;
+  Iterator begin() const;
+  Iterator end() const;
+
+ private:
+  const IS& is;
+
+  enum Kind {
+    General = 0,
+    Stride,
+    Block,
+  };
+  Kind kind;
+  Int n;
+
+  Int first = 0;
+  Int step = 1;
+  Int blockSize = 1;
+
+  /// @brief General indices or block indices of `Block` kind
+  const Int* indices = nullptr;
+  /// @brief Indices of `Stride` and `Block` kinds expanded by `span()`
+  const Int* expanded = nullptr;
+};
+
+
+class IS::BorrowedIndices::Iterator {
+ public:
+  Iterator(const BorrowedIndices& indices, Int current) : indices(indices), current(current) {}
+  ~Iterator() = default;
+
+  Int index() const { return current; }
+  Int value() const { return indices[current]; }
+
+  // Input iterator requirements
+  Int operator*() const { return indices[current]; }
+  Iterator& operator++() { current++; return *this; }
+  bool operator!=(const Iterator& other) const { return current != other.current; }
+
+  // Random access iterator requirements for OpenMP
+  Iterator& operator+=(Int difference) { current += difference; return *this; }
+  Int operator-(const Iterator& other) const { return current - other.current; }
+
+ private:
+  const BorrowedIndices& indices;
+  Int current;
+};
+
 }
 
 #endif // SRC_IS_H
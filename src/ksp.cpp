@@ -1,16 +1,116 @@
 #include "ksp.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
 namespace Petsc {
 
-KSP::KSP(std::string_view name) {
-  PetscCallThrow(KSPCreate(PETSC_COMM_WORLD, &that));
+namespace {
+
+std::string SplitName(const DA& da, const std::vector<Int>& fields) {
+  std::string name;
+  for (Int f : fields) {
+    if (!name.empty()) {
+      name += "_";
+    }
+    const char* fieldName = da.GetFieldName(f);
+    name += (fieldName && *fieldName) ? fieldName : std::to_string(f);
+  }
+  return name;
+}
+
+IS CreateSplitIS(MPI_Comm comm, Int points, Int localStart, Int dof, std::vector<Int> fields) {
+  if (fields.size() == 1) {
+    return IS::CreateStride(comm, points, localStart + fields[0], dof);
+  }
+  std::sort(fields.begin(), fields.end());
+
+  std::vector<Int> indices;
+  indices.reserve(points * fields.size());
+  for (Int p = 0; p < points; ++p) {
+    for (Int f : fields) {
+      indices.emplace_back(localStart + p * dof + f);
+    }
+  }
+  return IS::CreateGeneral(comm, indices.size(), indices.data(), PETSC_COPY_VALUES);
+}
+
+/// @brief Sets the types of an inner solver of a preconditioner
+void SetInnerSolver(::KSP ksp, KSPType kspType, PCType pcType) {
+  PC pc;
+  PetscCallThrow(KSPSetType(ksp, kspType));
+  PetscCallThrow(KSPGetPC(ksp, &pc));
+  PetscCallThrow(PCSetType(pc, pcType));
+}
+
+constexpr std::pair<std::string_view, std::string_view> pipelinedTypes[] = {
+  {KSPCG, KSPPIPECG},
+  {KSPCR, KSPPIPECR},
+  {KSPGCR, KSPPIPEGCR},
+  {KSPGMRES, KSPPGMRES},
+  {KSPFGMRES, KSPPIPEFGMRES},
+  {KSPBCGS, KSPPIPEBCGS},
+};
+
+struct ReductionCounters {
+  Int reductions = 0;
+  PetscLogDouble multTime = 0.0;
+  PetscLogDouble waitTime = 0.0;
+};
+
+#if defined(PETSC_USE_LOG)
+PetscLogStage OverlapStage() {
+  static PetscLogStage stage = -1;
+  if (stage < 0) {
+    PetscCallThrow(PetscLogStageRegister("KSP overlap", &stage));
+  }
+  return stage;
+}
+
+PetscEventPerfInfo GetPerfInfo(PetscLogStage stage, const char* name) {
+  PetscLogEvent event;
+  PetscEventPerfInfo info;
+  PetscCallThrow(PetscLogEventGetId(name, &event));
+  PetscCallThrow(PetscLogEventGetPerfInfo(stage, event, &info));
+  return info;
+}
+
+ReductionCounters GetReductionCounters(PetscLogStage stage) {
+  ReductionCounters counters;
+  counters.multTime = GetPerfInfo(stage, "MatMult").time;
+
+  // Split-phase reductions of pipelined methods wait in `VecReduceEnd`
+  counters.reductions += GetPerfInfo(stage, "VecReduceComm").count;
+  counters.waitTime += GetPerfInfo(stage, "VecReduceEnd").time;
+
+  for (const char* name : {"VecNorm", "VecDot", "VecTDot", "VecMDot", "VecMTDot"}) {
+    auto info = GetPerfInfo(stage, name);
+    counters.reductions += info.count;
+    counters.waitTime += info.time;
+  }
+  return counters;
+}
+#endif
+
+}
+
+KSP::KSP(std::string_view name)
+    : KSP(PETSC_COMM_WORLD, name) {}
+
+KSP::KSP(MPI_Comm comm, std::string_view name) {
+  PetscCallThrow(KSPCreate(comm, &that));
   if (!name.empty()) {
     PetscCallThrow(PetscObjectSetName(*this, name.data()));
   }
 }
 
 KSP KSP::FromOptions(std::string_view name) {
-  KSP ksp(name);
+  return FromOptions(PETSC_COMM_WORLD, name);
+}
+
+KSP KSP::FromOptions(MPI_Comm comm, std::string_view name) {
+  KSP ksp(comm, name);
   PetscCallThrow(KSPSetFromOptions(ksp));
   return ksp;
 }
@@ -35,8 +135,231 @@ void KSP::SetUp() {
   PetscCallThrow(KSPSetUp(that));
 }
 
+void KSP::SetFieldSplit(const DA& da) {
+  std::vector<std::vector<Int>> splits(da.GetDof());
+  for (Int f = 0; f < (Int)splits.size(); ++f) {
+    splits[f] = {f};
+  }
+  SetFieldSplit(da, splits);
+}
+
+void KSP::SetFieldSplit(const DA& da, const std::vector<std::vector<Int>>& splits) {
+  PC pc;
+  PetscCallThrow(KSPGetPC(that, &pc));
+  PetscCallThrow(PCSetType(pc, PCFIELDSPLIT));
+
+  MPI_Comm comm = PetscObjectComm(da);
+  Int dof = da.GetDof();
+  auto [_, size] = da.GetCorners();
+  Int points = size.x * size.y * size.z;
+
+  // DA global ordering is contiguous on each process with dof values interlaced
+  Int localSize = points * dof, localStart;
+  PetscCallMPIThrow(MPI_Scan(&localSize, &localStart, 1, MPIU_INT, MPI_SUM, comm));
+  localStart -= localSize;
+
+  splitNames.clear();
+  for (const auto& fields : splits) {
+    if (fields.empty()) {
+      PetscCallThrow(PETSC_ERR_ARG_WRONG);
+    }
+    for (Int f : fields) {
+      if (f < 0 || f >= dof) {
+        PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+      }
+    }
+
+    IS is = CreateSplitIS(comm, points, localStart, dof, fields);
+    splitNames.emplace_back(SplitName(da, fields));
+    PetscCallThrow(PCFieldSplitSetIS(pc, splitNames.back().c_str(), is));
+  }
+}
+
+void KSP::SetFieldSplitSchur(SchurFactType factType, SchurPreType preType) {
+  if (splitNames.size() != 2) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+
+  PC pc;
+  PetscCallThrow(KSPGetPC(that, &pc));
+  PetscCallThrow(PCFieldSplitSetType(pc, PC_COMPOSITE_SCHUR));
+  PetscCallThrow(PCFieldSplitSetSchurFactType(pc, factType));
+  PetscCallThrow(PCFieldSplitSetSchurPre(pc, preType, NULL));
+}
+
+void KSP::SetFieldSplitSubSolver(Int split, KSPType kspType, PCType pcType) {
+  // Only the preconditioner is set up, the inner solvers are set up by its first application
+  PC pc;
+  PetscCallThrow(KSPGetPC(that, &pc));
+  PetscCallThrow(PCSetUp(pc));
+
+  Int n;
+  ::KSP* subksp;
+  PetscCallThrow(PCFieldSplitGetSubKSP(pc, &n, &subksp));
+
+  ::KSP ksp = (split >= 0 && split < n) ? subksp[split] : NULL;
+  PetscCallThrow(PetscFree(subksp));
+  if (!ksp) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+  SetInnerSolver(ksp, kspType, pcType);
+}
+
+void KSP::SetTelescope(Int reductionFactor) {
+  PC pc;
+  PetscCallThrow(KSPGetPC(that, &pc));
+  PetscCallThrow(PCSetType(pc, PCTELESCOPE));
+
+  if (reductionFactor == PETSC_DETERMINE) {
+    MPIInt size;
+    PetscCallMPIThrow(MPI_Comm_size(PetscObjectComm(*this), &size));
+    reductionFactor = size;
+  }
+  PetscCallThrow(PCTelescopeSetReductionFactor(pc, reductionFactor));
+  PetscCallThrow(PCTelescopeSetSubcommType(pc, PETSC_SUBCOMM_CONTIGUOUS));
+}
+
+void KSP::SetTelescopeSubSolver(KSPType kspType, PCType pcType) {
+  PC pc;
+  ::KSP ksp;
+  PetscCallThrow(KSPGetPC(that, &pc));
+  PetscCallThrow(PCSetUp(pc));
+
+  // Processes outside of the reduced communicator have no inner solver
+  PetscCallThrow(PCTelescopeGetKSP(pc, &ksp));
+  if (ksp) {
+    SetInnerSolver(ksp, kspType, pcType);
+  }
+}
+
+void KSP::SetLatencyHiding(Bool flag) {
+  KSPType type;
+  PetscCallThrow(KSPGetType(that, &type));
+  std::string_view current = type ? type : KSPGMRES;
+
+  for (auto [blocking, pipelined] : pipelinedTypes) {
+    if (flag && current == blocking) {
+      PetscCallThrow(KSPSetType(that, pipelined.data()));
+      return;
+    }
+    if (!flag && current == pipelined) {
+      PetscCallThrow(KSPSetType(that, blocking.data()));
+      return;
+    }
+  }
+}
+
+/* static */ void KSP::EnableAsyncProgress() {
+  int initialized;
+  PetscCallMPIThrow(MPI_Initialized(&initialized));
+  if (initialized) {
+    PetscCallThrow(PETSC_ERR_ORDER);
+  }
+
+  // Progress threads of MPICH derivatives and Intel MPI, user values are kept
+  setenv("MPIR_CVAR_ASYNC_PROGRESS", "1", 0);
+  setenv("MPICH_ASYNC_PROGRESS", "1", 0);
+  setenv("I_MPI_ASYNC_PROGRESS", "1", 0);
+}
+
+void KSP::SetOverlapDiagnostics(Bool flag) {
+  overlap = {};
+  if (!flag) {
+    diagnostics = PETSC_FALSE;
+    return;
+  }
+
+#if defined(PETSC_USE_LOG)
+  Bool active;
+  PetscCallThrow(PetscLogIsActive(&active));
+  if (!active) {
+    PetscCallThrow(PetscLogDefaultBegin());
+  }
+#else
+  PetscCallThrow(PETSC_ERR_SUP);
+#endif
+  diagnostics = PETSC_TRUE;
+
+  // Reference cost of the reductions that the pipelined methods try to hide
+  constexpr int samples = 100;
+  MPI_Comm comm = PetscObjectComm(*this);
+  Scalar in[3] = {1.0, 1.0, 1.0}, out[3];
+
+  PetscCallMPIThrow(MPI_Allreduce(in, out, 3, MPIU_SCALAR, MPIU_SUM, comm));
+  PetscCallMPIThrow(MPI_Barrier(comm));
+
+  PetscLogDouble start = MPI_Wtime();
+  for (int i = 0; i < samples; ++i) {
+    PetscCallMPIThrow(MPI_Allreduce(in, out, 3, MPIU_SCALAR, MPIU_SUM, comm));
+  }
+  PetscLogDouble latency = (MPI_Wtime() - start) / samples;
+  PetscCallMPIThrow(MPI_Allreduce(&latency, &overlap.allreduceLatency, 1, MPI_DOUBLE, MPI_MAX, comm));
+}
+
+KSP::OverlapInfo KSP::GetOverlapInfo() const {
+  OverlapInfo info = overlap;
+
+  PetscLogDouble local[3] = {overlap.solveTime, overlap.multTime, overlap.waitTime};
+  PetscLogDouble global[3];
+  PetscCallMPIThrow(MPI_Allreduce(local, global, 3, MPI_DOUBLE, MPI_MAX, PetscObjectComm(*this)));
+  info.solveTime = global[0];
+  info.multTime = global[1];
+  info.waitTime = global[2];
+
+  PetscCallMPIThrow(MPI_Allreduce(&overlap.reductions, &info.reductions, 1, MPIU_INT, MPI_MAX, PetscObjectComm(*this)));
+
+  // Estimate only: without overlap every reduction is expected to block for the full latency, which
+  // the pipelined reductions do not have to match on a loaded network
+  info.hiddenTime = std::max(0.0, info.reductions * info.allreduceLatency - info.waitTime);
+  return info;
+}
+
+void KSP::ViewOverlapInfo(PetscViewer viewer) const {
+  OverlapInfo info = GetOverlapInfo();
+  PetscLogDouble expected = info.reductions * info.allreduceLatency;
+  PetscLogDouble fraction = expected > 0.0 ? info.hiddenTime / expected : 0.0;
+
+  KSPType type;
+  PetscCallThrow(KSPGetType(that, &type));
+  PetscCallThrow(PetscViewerASCIIPrintf(viewer, "KSP overlap diagnostics (%s):\n", type));
+  PetscCallThrow(PetscViewerASCIIPushTab(viewer));
+  PetscCallThrow(PetscViewerASCIIPrintf(viewer, "solves: %" PetscInt_FMT ", iterations: %" PetscInt_FMT "\n", info.solves, info.iterations));
+  PetscCallThrow(PetscViewerASCIIPrintf(viewer, "solve time: %g s, MatMult time: %g s\n", info.solveTime, info.multTime));
+  PetscCallThrow(PetscViewerASCIIPrintf(viewer, "reductions: %" PetscInt_FMT ", allreduce latency: %g s\n", info.reductions, info.allreduceLatency));
+  PetscCallThrow(PetscViewerASCIIPrintf(viewer, "blocked on reductions: %g s, expected without overlap: %g s\n", info.waitTime, expected));
+  PetscCallThrow(PetscViewerASCIIPrintf(viewer, "estimated hidden reduction time: %g s (%.1f%%)\n", info.hiddenTime, 100.0 * fraction));
+  PetscCallThrow(PetscViewerASCIIPopTab(viewer));
+}
+
 void KSP::Solve(const Petsc::Vec& rhs, Petsc::Vec& solution) {
+#if defined(PETSC_USE_LOG)
+  PetscLogStage stage = -1;
+  ReductionCounters before;
+  PetscLogDouble start = 0.0;
+  if (diagnostics) {
+    stage = OverlapStage();
+    before = GetReductionCounters(stage);
+    PetscCallThrow(PetscLogStagePush(stage));
+    start = MPI_Wtime();
+  }
+#endif
+
   PetscCallThrow(KSPSolve(that, rhs, solution));
+
+#if defined(PETSC_USE_LOG)
+  if (diagnostics) {
+    PetscLogDouble end = MPI_Wtime();
+    PetscCallThrow(PetscLogStagePop());
+
+    ReductionCounters after = GetReductionCounters(stage);
+    overlap.solves += 1;
+    overlap.iterations += GetIterationNumber();
+    overlap.reductions += after.reductions - before.reductions;
+    overlap.solveTime += end - start;
+    overlap.multTime += after.multTime - before.multTime;
+    overlap.waitTime += after.waitTime - before.waitTime;
+  }
+#endif
 }
 
 void KSP::GetSolution(Petsc::Vec& solution) const {
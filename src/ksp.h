@@ -1,7 +1,9 @@
 #ifndef SRC_KSP_H
 #define SRC_KSP_H
 
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include <petscksp.h>
 
@@ -9,15 +11,18 @@
 #include "utils.h"
 #include "vec.h"
 #include "mat.h"
+#include "dmda.h"
 
 namespace Petsc {
 
 class KSP {
  public:
   KSP(std::string_view name = {});
+  KSP(MPI_Comm comm, std::string_view name = {});
   PETSC_DEFAULT_COPY_POLICY(KSP);
 
   static KSP FromOptions(std::string_view name = {});
+  static KSP FromOptions(MPI_Comm comm, std::string_view name = {});
 
   void SetOperators(Mat& linearOp, Mat& preconditionOp);
   void SetTolerances(Real relativeTol, Real absoluteTol, Real divergenceTol, Int itNumber);
@@ -25,6 +30,52 @@ class KSP {
   void SetFromOptions();
   void SetUp();
 
+  // Field-split preconditioning
+  using SchurFactType = PCFieldSplitSchurFactType;
+  using SchurPreType = PCFieldSplitSchurPreType;
+
+  /// @brief Creates one split per DA field, named after `DA::GetFieldName()`
+  void SetFieldSplit(const DA& da);
+  /// @brief Creates one split per group of DA fields, e.g. {{0, 1}, {2}} for velocity-pressure
+  void SetFieldSplit(const DA& da, const std::vector<std::vector<Int>>& splits);
+  /// @brief Switches two-split preconditioner to the Schur complement factorization
+  void SetFieldSplitSchur(SchurFactType factType, SchurPreType preType);
+  /// @brief Sets the solver of a split, for Schur factorization the second one is the Schur complement solver
+  /// @note Operators should be set, the preconditioner is set up to create the inner solvers
+  void SetFieldSplitSubSolver(Int split, KSPType kspType, PCType pcType);
+
+  // Telescoping onto a reduced communicator
+  /// @brief Solves the preconditioner system on `size / reductionFactor` processes, on one with `PETSC_DETERMINE`
+  /// @note Redistribution and its scatters are reused by the next setups with the same nonzero pattern
+  void SetTelescope(Int reductionFactor);
+  /// @note Operators should be set, the preconditioner is set up to create the inner solver and
+  /// processes outside of the reduced communicator are left untouched
+  void SetTelescopeSubSolver(KSPType kspType, PCType pcType);
+
+  // Latency hiding with pipelined Krylov methods
+  struct OverlapInfo {
+    Int solves;
+    Int iterations;
+    Int reductions;                   ///< number of global reductions
+    PetscLogDouble solveTime;
+    PetscLogDouble multTime;          ///< time spent in `MatMult`
+    PetscLogDouble waitTime;          ///< time blocked on global reductions
+    PetscLogDouble allreduceLatency;  ///< measured latency of a blocking allreduce
+    PetscLogDouble hiddenTime;        ///< estimated reductions time overlapped with other work
+  };
+
+  /// @brief Replaces CG, CR, GCR, GMRES, FGMRES and BCGS with their pipelined variants
+  void SetLatencyHiding(Bool flag);
+  /// @note Should be called before `Context::Instance()`, MPI reads it at initialization
+  static void EnableAsyncProgress();
+
+  /// @brief Collects PETSc log events of the subsequent solves, enables logging if needed
+  void SetOverlapDiagnostics(Bool flag);
+  /// @note Collective, times are maximized over the processes. The hidden time is not measured, it is
+  /// the measured latency times the number of reductions minus the time blocked on them.
+  OverlapInfo GetOverlapInfo() const;
+  void ViewOverlapInfo(PetscViewer viewer) const;
+
   void Solve(const Vec& rhs, Vec& solution);
   void GetSolution(Vec& solution) const;
 
@@ -43,6 +94,12 @@ class KSP {
 
  private:
   _p_KSP* that = nullptr;
+
+  /// @brief Names of the splits of `SetFieldSplit()`
+  std::vector<std::string> splitNames;
+
+  Bool diagnostics = PETSC_FALSE;
+  OverlapInfo overlap = {};
 };
 
 }
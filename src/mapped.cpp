@@ -0,0 +1,220 @@
+#include "mapped.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <petscmat.h>
+
+namespace Petsc {
+
+namespace {
+
+/// @brief Reads a big-endian integer of the file, which may be unaligned
+Int ReadInt(const char* at) {
+  Int value;
+  std::copy_n(at, sizeof(Int), reinterpret_cast<char*>(&value));
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  PetscCallThrow(PetscByteSwap(&value, PETSC_INT, 1));
+#endif
+  return value;
+}
+
+std::size_t GetWidth(PetscDataType type) {
+  return type == PETSC_SCALAR ? sizeof(Scalar) : sizeof(Int);
+}
+
+std::size_t GetAlignment(PetscDataType type) {
+  return type == PETSC_SCALAR ? alignof(Scalar) : alignof(Int);
+}
+
+}
+
+MappedBinaryFile::MappedBinaryFile(std::string_view filename) {
+  std::string name(filename);
+  int fd = open(name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    PetscCallThrow(PETSC_ERR_FILE_OPEN);
+  }
+
+  // Private writable pages are copied only when a section is swapped, the file is never changed
+  struct stat status;
+  bool mapped = fstat(fd, &status) == 0;
+  if (mapped && status.st_size > 0) {
+    bytes = status.st_size;
+    void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    mapped = address != MAP_FAILED;
+    map = mapped ? static_cast<char*>(address) : nullptr;
+  }
+  close(fd);
+  if (!mapped) {
+    PetscCallThrow(PETSC_ERR_FILE_OPEN);
+  }
+
+  std::size_t cursor = 0;
+  bool valid = true;
+  auto section = [&](Int64 count, PetscDataType type) {
+    Section s;
+    s.offset = cursor;
+    s.count = count;
+    s.type = type;
+    valid = valid && count >= 0 && (std::size_t)count <= (bytes - cursor) / GetWidth(type);
+    cursor = valid ? cursor + (std::size_t)count * GetWidth(type) : bytes;
+    return s;
+  };
+
+  while (valid && cursor < bytes) {
+    Object object = {VecObject, 0, 1, 0, cursor};
+    Int header[4] = {0, 0, 0, 0};
+    Int words = bytes - cursor >= sizeof(Int) && ReadInt(map + cursor) == MAT_FILE_CLASSID ? 4 : 2;
+    if (bytes - cursor < words * sizeof(Int)) {
+      valid = false;
+      break;
+    }
+    for (Int w = 0; w < words; ++w) {
+      header[w] = ReadInt(map + cursor + w * sizeof(Int));
+    }
+    cursor += words * sizeof(Int);
+
+    std::vector<Section> parts;
+    switch (header[0]) {
+      case VEC_FILE_CLASSID:
+        object.rows = header[1];
+        parts.emplace_back(section(header[1], PETSC_SCALAR));
+        break;
+      case IS_FILE_CLASSID:
+        object.type = ISObject;
+        object.rows = header[1];
+        parts.emplace_back(section(header[1], PETSC_INT));
+        break;
+      case MAT_FILE_CLASSID:
+        object.type = MatObject;
+        object.rows = header[1];
+        object.cols = header[2];
+        object.nonzeros = header[3];
+        if (header[3] == MATRIX_BINARY_FORMAT_DENSE) {
+          parts.emplace_back(section(0, PETSC_INT));
+          parts.emplace_back(section(0, PETSC_INT));
+          // Dense sizes are multiplied in 64 bits, the entries may not fit into `Int`
+          bool sized = header[1] >= 0 && header[2] >= 0 &&
+                       (header[2] == 0 || (Int64)header[1] <= std::numeric_limits<Int64>::max() / header[2]);
+          parts.emplace_back(section(sized ? (Int64)header[1] * header[2] : -1, PETSC_SCALAR));
+        }
+        else {
+          parts.emplace_back(section(header[1], PETSC_INT));
+          parts.emplace_back(section(header[3], PETSC_INT));
+          parts.emplace_back(section(header[3], PETSC_SCALAR));
+        }
+        break;
+      default:
+        valid = false;
+        break;
+    }
+
+    objects.emplace_back(object);
+    sections.emplace_back(std::move(parts));
+  }
+
+  if (!valid) {
+    Close();
+    PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+  }
+}
+
+const MappedBinaryFile::Object& MappedBinaryFile::GetObject(std::size_t n) const {
+  if (n >= objects.size()) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+  return objects[n];
+}
+
+void* MappedBinaryFile::Prepare(Section& section) {
+  if (section.prepared) {
+    return section.data;
+  }
+
+  char* at = map + section.offset;
+  if (reinterpret_cast<std::uintptr_t>(at) % GetAlignment(section.type) != 0) {
+    std::size_t size = (std::size_t)section.count * GetWidth(section.type);
+    section.copy.resize((size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+    char* copy = reinterpret_cast<char*>(section.copy.data());
+    std::copy_n(at, size, copy);
+    at = copy;
+  }
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  PetscCallThrow(PetscByteSwap(at, section.type, section.count));
+#endif
+
+  section.data = at;
+  section.prepared = true;
+  return at;
+}
+
+std::span<const Scalar> MappedBinaryFile::GetValues(std::size_t n) {
+  const auto& object = GetObject(n);
+  if (object.type == ISObject) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+  auto& section = sections[n][object.type == VecObject ? 0 : 2];
+  return {static_cast<const Scalar*>(Prepare(section)), (std::size_t)section.count};
+}
+
+std::span<const Int> MappedBinaryFile::GetRowLengths(std::size_t n) {
+  if (GetObject(n).type != MatObject) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+  auto& section = sections[n][0];
+  return {static_cast<const Int*>(Prepare(section)), (std::size_t)section.count};
+}
+
+std::span<const Int> MappedBinaryFile::GetColumnIndices(std::size_t n) {
+  if (GetObject(n).type != MatObject) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+  auto& section = sections[n][1];
+  return {static_cast<const Int*>(Prepare(section)), (std::size_t)section.count};
+}
+
+std::span<const Int> MappedBinaryFile::GetIndices(std::size_t n) {
+  if (GetObject(n).type != ISObject) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+  auto& section = sections[n][0];
+  return {static_cast<const Int*>(Prepare(section)), (std::size_t)section.count};
+}
+
+Vec MappedBinaryFile::GetVec(std::size_t n) {
+  if (GetObject(n).type != VecObject) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+  auto values = GetValues(n);
+
+  Vec vec;
+  PetscCallThrow(VecCreateSeqWithArray(PETSC_COMM_SELF, 1, (Int)values.size(), const_cast<Scalar*>(values.data()), vec));
+  return vec;
+}
+
+void MappedBinaryFile::Close() {
+  objects.clear();
+  sections.clear();
+  if (map) {
+    int status = munmap(map, bytes);
+    map = nullptr;
+    bytes = 0;
+    if (status != 0) {
+      PetscCallThrow(PETSC_ERR_SYS);
+    }
+  }
+}
+
+MappedBinaryFile::~MappedBinaryFile() noexcept(false) {
+  Close();
+}
+
+}
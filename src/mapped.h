@@ -0,0 +1,91 @@
+#ifndef SRC_MAPPED_H
+#define SRC_MAPPED_H
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <petscsys.h>
+
+#include "exception.h"
+#include "utils.h"
+#include "vec.h"
+
+namespace Petsc {
+
+/// @brief Read-only access to the objects of a PETSc binary file through a private memory mapping.
+/// Opening only parses the object headers. Sections are byte-swapped in place on their first access,
+/// so the untouched pages stay shared with the page cache. Sections that are not aligned for their
+/// type, as the values of a matrix with an odd number of 32-bit indices, are copied once.
+/// @note Spans and vectors are valid until `Close()`, the object is not thread-safe
+/// @note On little-endian hosts the swap writes every page of an accessed section, which becomes a
+/// private copy of each process. Only the sections never accessed stay shared, so processes that read
+/// the same file do not share the memory of the sections they read.
+class MappedBinaryFile {
+ public:
+  /// @brief Objects written by `VecView()`, `MatView()` and `ISView()`
+  enum ObjectType {
+    VecObject = 0,
+    MatObject,
+    ISObject,
+  };
+
+  struct Object {
+    ObjectType type;
+    /// @brief Size of vectors and index sets, rows of matrices
+    Int rows;
+    Int cols;
+    /// @brief Nonzeros of AIJ matrices, `MATRIX_BINARY_FORMAT_DENSE` for dense ones
+    Int nonzeros;
+    /// @brief Position of the object header in the file
+    std::size_t offset;
+  };
+
+  MappedBinaryFile(std::string_view filename);
+  PETSC_NO_COPY_POLICY(MappedBinaryFile);
+
+  std::size_t GetNumObjects() const { return objects.size(); }
+  const Object& GetObject(std::size_t n) const;
+
+  /// @brief Entries of a vector, nonzeros of an AIJ matrix or row-major entries of a dense one
+  std::span<const Scalar> GetValues(std::size_t n);
+  /// @brief Number of nonzeros per row and their columns, AIJ matrices only
+  std::span<const Int> GetRowLengths(std::size_t n);
+  std::span<const Int> GetColumnIndices(std::size_t n);
+  /// @brief Indices of an index set
+  std::span<const Int> GetIndices(std::size_t n);
+
+  /// @brief Sequential vector on `PETSC_COMM_SELF` over the mapped entries of the vector `n`, nothing
+  /// is copied. Changes of the vector stay in the private mapping and never reach the file.
+  Vec GetVec(std::size_t n);
+
+  void Close();
+  ~MappedBinaryFile() noexcept(false);
+
+ private:
+  /// @brief Array of `count` elements of `type` at `offset`, big-endian until prepared
+  struct Section {
+    std::size_t offset = 0;
+    Int64 count = 0;
+    PetscDataType type = PETSC_INT;
+    bool prepared = false;
+    /// @brief Native pointer to the section, into the mapping or into `copy`
+    void* data = nullptr;
+    std::vector<std::max_align_t> copy;
+  };
+
+  /// @brief Swaps the section to the native order on the first call, copies it if misaligned
+  void* Prepare(Section& section);
+
+  char* map = nullptr;
+  std::size_t bytes = 0;
+
+  std::vector<Object> objects;
+  /// @brief Values of vectors, lengths, columns and values of matrices, indices of index sets
+  std::vector<std::vector<Section>> sections;
+};
+
+}
+
+#endif // SRC_MAPPED_H
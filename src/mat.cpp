@@ -2,8 +2,11 @@
 
 namespace Petsc {
 
-Mat::Mat(Int localRows, Int localCols, Int globalRows, Int globalCols, std::string_view name) {
-  PetscCallThrow(MatCreate(PETSC_COMM_WORLD, &that));
+Mat::Mat(Int localRows, Int localCols, Int globalRows, Int globalCols, std::string_view name)
+    : Mat(PETSC_COMM_WORLD, localRows, localCols, globalRows, globalCols, name) {}
+
+Mat::Mat(MPI_Comm comm, Int localRows, Int localCols, Int globalRows, Int globalCols, std::string_view name) {
+  PetscCallThrow(MatCreate(comm, &that));
   PetscCallThrow(MatSetSizes(that, localRows, localCols, globalRows, globalCols));
   PetscCallThrow(MatSetType(that, MATAIJ)); // compressed sparse row storage by default
   PetscCallThrow(MatSetUp(that));           // explicitly setting up internal mat structures
@@ -13,15 +16,27 @@ Mat::Mat(Int localRows, Int localCols, Int globalRows, Int globalCols, std::stri
 }
 
 /* static */ Mat Mat::FromLocals(Int localRows, Int localCols, std::string_view name) {
-  return FromOptions(localRows, localCols, PETSC_DETERMINE, PETSC_DETERMINE, name);
+  return FromOptions(PETSC_COMM_WORLD, localRows, localCols, PETSC_DETERMINE, PETSC_DETERMINE, name);
+}
+
+/* static */ Mat Mat::FromLocals(MPI_Comm comm, Int localRows, Int localCols, std::string_view name) {
+  return FromOptions(comm, localRows, localCols, PETSC_DETERMINE, PETSC_DETERMINE, name);
 }
 
 /* static */ Mat Mat::FromGlobals(Int globalRows, Int globalCols, std::string_view name) {
-  return FromOptions(PETSC_DECIDE, PETSC_DECIDE, globalRows, globalCols, name);
+  return FromOptions(PETSC_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, globalRows, globalCols, name);
+}
+
+/* static */ Mat Mat::FromGlobals(MPI_Comm comm, Int globalRows, Int globalCols, std::string_view name) {
+  return FromOptions(comm, PETSC_DECIDE, PETSC_DECIDE, globalRows, globalCols, name);
 }
 
 /* static */ Mat Mat::FromOptions(Int localRows, Int localCols, Int globalRows, Int globalCols, std::string_view name) {
-  Mat mat(localRows, localCols, globalRows, globalCols, name);
+  return FromOptions(PETSC_COMM_WORLD, localRows, localCols, globalRows, globalCols, name);
+}
+
+/* static */ Mat Mat::FromOptions(MPI_Comm comm, Int localRows, Int localCols, Int globalRows, Int globalCols, std::string_view name) {
+  Mat mat(comm, localRows, localCols, globalRows, globalCols, name);
   PetscCallThrow(MatSetFromOptions(mat));
   return mat;
 }
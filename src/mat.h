@@ -17,11 +17,15 @@ class Mat {
 
   Mat() = default;
   Mat(Int localRows, Int localCols, Int globalRows, Int globalCols, std::string_view name = {});
+  Mat(MPI_Comm comm, Int localRows, Int localCols, Int globalRows, Int globalCols, std::string_view name = {});
   PETSC_DEFAULT_COPY_POLICY(Mat);
 
   static Mat FromLocals(Int localRows, Int localCols, std::string_view name = {});
+  static Mat FromLocals(MPI_Comm comm, Int localRows, Int localCols, std::string_view name = {});
   static Mat FromGlobals(Int globalRows, Int globalCols, std::string_view name = {});
+  static Mat FromGlobals(MPI_Comm comm, Int globalRows, Int globalCols, std::string_view name = {});
   static Mat FromOptions(Int localRows, Int localCols, Int globalRows, Int globalCols, std::string_view name = {});
+  static Mat FromOptions(MPI_Comm comm, Int localRows, Int localCols, Int globalRows, Int globalCols, std::string_view name = {});
 
   std::pair<Int, Int> GetSize() const;
   std::pair<Int, Int> GetLocalSize() const;
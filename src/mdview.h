@@ -0,0 +1,101 @@
+#ifndef SRC_MDVIEW_H
+#define SRC_MDVIEW_H
+
+#include <type_traits>
+
+#include "utils.h"
+
+namespace Petsc {
+
+/// @brief Marks the number of components that is known at runtime only
+inline constexpr Int dynamicExtent = -1;
+
+/// @brief Non-owning view of a DOF-interlaced grid array, one base pointer plus strides.
+/// Indices are global grid indices in the PETSc order `(k, j, i, c)`, the component
+/// index `c` is omitted for `Dof == 1`. The layout is defined by the corner and the
+/// size of the stored box, so the same view serves local (ghosted) and global arrays.
+template<typename T, Int Dim, Int Dof = 1>
+class MDView {
+  static_assert(Dim >= 1 && Dim <= 3, "Grid dimension should be 1, 2 or 3");
+  static_assert(Dof > 0 || Dof == dynamicExtent, "Number of components should be positive");
+
+ public:
+  static constexpr Int rank = Dim + (Dof != 1 ? 1 : 0);
+
+  MDView() = default;
+  MDView(T* data, Int3 corner, Int3 size, Int dof = Dof);
+
+  template<typename... Idx>
+  T& operator()(Idx... idx) const;
+
+  T* data() const { return ptr; }
+  Int3 GetCorner() const { return corner; }
+  Int3 GetSize() const { return size; }
+
+  constexpr Int GetDof() const {
+    if constexpr (Dof != dynamicExtent) {
+      return Dof;
+    }
+    else {
+      return dof;
+    }
+  }
+
+ protected:
+  void Reset(T* data, Int3 corner, Int3 size, Int dof = Dof);
+
+  T* ptr = nullptr;
+  Int3 corner = 0;
+  Int3 size = 0;
+  Int dof = Dof;
+
+  Int strideY = 0;
+  Int strideZ = 0;
+
+  /// @brief Linear index of the global grid origin, it is subtracted from each access
+  Int offset = 0;
+};
+
+template<typename T, Int Dim, Int Dof>
+MDView<T, Dim, Dof>::MDView(T* data, Int3 corner, Int3 size, Int dof) {
+  Reset(data, corner, size, dof);
+}
+
+template<typename T, Int Dim, Int Dof>
+void MDView<T, Dim, Dof>::Reset(T* data, Int3 corner, Int3 size, Int dof) {
+  this->ptr = data;
+  this->corner = corner;
+  this->size = size;
+  this->dof = dof;
+
+  strideY = size.x * GetDof();
+  strideZ = size.y * strideY;
+  offset = corner.z * strideZ + corner.y * strideY + corner.x * GetDof();
+}
+
+template<typename T, Int Dim, Int Dof>
+template<typename... Idx>
+T& MDView<T, Dim, Dof>::operator()(Idx... idx) const {
+  static_assert(sizeof...(Idx) == rank, "Number of indices should match the view rank");
+  const Int index[] = {static_cast<Int>(idx)...};
+
+  Int linear = -offset;
+  if constexpr (Dim == 3) {
+    linear += index[0] * strideZ + index[1] * strideY + index[2] * GetDof();
+  }
+  else if constexpr (Dim == 2) {
+    linear += index[0] * strideY + index[1] * GetDof();
+  }
+  else {
+    linear += index[0] * GetDof();
+  }
+
+  if constexpr (Dof != 1) {
+    linear += index[Dim];
+  }
+  return ptr[linear];
+}
+
+}
+
+#endif // SRC_MDVIEW_H
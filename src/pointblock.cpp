@@ -0,0 +1,242 @@
+#include "pointblock.h"
+
+#include <algorithm>
+
+namespace Petsc {
+
+namespace {
+
+constexpr Int lanes = PointBlockSolver::lanes;
+
+/// @returns `true` if zero pivot was found in any of the lanes
+bool FactorTile(Int dof, Scalar* a, Int* piv) {
+  bool singular = false;
+
+  for (Int k = 0; k < dof; ++k) {
+    Int p[lanes];
+    Real best[lanes];
+
+    #pragma omp simd
+    for (Int l = 0; l < lanes; ++l) {
+      p[l] = k;
+      best[l] = PetscAbsScalar(a[(k * dof + k) * lanes + l]);
+    }
+
+    for (Int r = k + 1; r < dof; ++r) {
+      #pragma omp simd
+      for (Int l = 0; l < lanes; ++l) {
+        Real v = PetscAbsScalar(a[(r * dof + k) * lanes + l]);
+        bool m = v > best[l];
+        best[l] = m ? v : best[l];
+        p[l] = m ? r : p[l];
+      }
+    }
+
+    // Rows are swapped with blends, since each lane has its own pivot
+    for (Int r = k + 1; r < dof; ++r) {
+      for (Int c = 0; c < dof; ++c) {
+        Scalar* ak = &a[(k * dof + c) * lanes];
+        Scalar* ar = &a[(r * dof + c) * lanes];
+
+        #pragma omp simd
+        for (Int l = 0; l < lanes; ++l) {
+          bool m = p[l] == r;
+          Scalar x = ak[l];
+          Scalar y = ar[l];
+          ak[l] = m ? y : x;
+          ar[l] = m ? x : y;
+        }
+      }
+    }
+
+    Scalar inv[lanes];
+    Scalar* akk = &a[(k * dof + k) * lanes];
+
+    #pragma omp simd reduction(||: singular)
+    for (Int l = 0; l < lanes; ++l) {
+      piv[k * lanes + l] = p[l];
+      singular = singular || best[l] == 0.0;
+      inv[l] = 1.0 / akk[l];
+      akk[l] = inv[l];
+    }
+
+    for (Int r = k + 1; r < dof; ++r) {
+      Scalar* ark = &a[(r * dof + k) * lanes];
+
+      #pragma omp simd
+      for (Int l = 0; l < lanes; ++l) {
+        ark[l] *= inv[l];
+      }
+
+      for (Int c = k + 1; c < dof; ++c) {
+        Scalar* arc = &a[(r * dof + c) * lanes];
+        const Scalar* akc = &a[(k * dof + c) * lanes];
+
+        #pragma omp simd
+        for (Int l = 0; l < lanes; ++l) {
+          arc[l] -= ark[l] * akc[l];
+        }
+      }
+    }
+  }
+  return singular;
+}
+
+void SolveTile(Int dof, const Scalar* a, const Int* piv, Scalar* x) {
+  for (Int k = 0; k < dof; ++k) {
+    #pragma omp simd
+    for (Int l = 0; l < lanes; ++l) {
+      Int p = piv[k * lanes + l];
+      Scalar t = x[p * lanes + l];
+      x[p * lanes + l] = x[k * lanes + l];
+      x[k * lanes + l] = t;
+    }
+  }
+
+  // Forward substitution with unit lower triangular L
+  for (Int r = 1; r < dof; ++r) {
+    for (Int c = 0; c < r; ++c) {
+      const Scalar* arc = &a[(r * dof + c) * lanes];
+
+      #pragma omp simd
+      for (Int l = 0; l < lanes; ++l) {
+        x[r * lanes + l] -= arc[l] * x[c * lanes + l];
+      }
+    }
+  }
+
+  // Backward substitution with U, its diagonal is stored inverted
+  for (Int r = dof - 1; r >= 0; --r) {
+    for (Int c = r + 1; c < dof; ++c) {
+      const Scalar* arc = &a[(r * dof + c) * lanes];
+
+      #pragma omp simd
+      for (Int l = 0; l < lanes; ++l) {
+        x[r * lanes + l] -= arc[l] * x[c * lanes + l];
+      }
+    }
+
+    const Scalar* arr = &a[(r * dof + r) * lanes];
+
+    #pragma omp simd
+    for (Int l = 0; l < lanes; ++l) {
+      x[r * lanes + l] *= arr[l];
+    }
+  }
+}
+
+PetscErrorCode ApplyPointBlock(PC pc, ::Vec x, ::Vec y) {
+  PetscFunctionBeginUser;
+  const PointBlockSolver* solver;
+  PetscCall(PCShellGetContext(pc, &solver));
+
+  Int localSize;
+  PetscCall(VecGetLocalSize(x, &localSize));
+  PetscCheck(localSize == solver->GetDof() * solver->GetNumPoints(), PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ,
+    "Local size %" PetscInt_FMT " does not match the factored blocks", localSize);
+
+  const Scalar* in;
+  Scalar* out;
+  PetscCall(VecGetArrayRead(x, &in));
+  PetscCall(VecGetArrayWrite(y, &out));
+  solver->Solve(in, out);
+  PetscCall(VecRestoreArrayWrite(y, &out));
+  PetscCall(VecRestoreArrayRead(x, &in));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+}
+
+PointBlockSolver::PointBlockSolver(Int dof) : dof(dof) {
+  if (dof <= 0) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+}
+
+void PointBlockSolver::Factor(Int points, const Scalar* blocks) {
+  this->points = points;
+
+  Int tiles = (points + lanes - 1) / lanes;
+  Int size = dof * dof;
+  factors.resize(tiles * size * lanes);
+  pivots.resize(tiles * dof * lanes);
+
+  bool singular = false;
+
+  #pragma omp parallel for schedule(static) reduction(||: singular)
+  for (Int t = 0; t < tiles; ++t) {
+    Scalar* a = &factors[t * size * lanes];
+
+    // Transposition into the tile, padding points are identity blocks
+    for (Int l = 0; l < lanes; ++l) {
+      Int point = t * lanes + l;
+      for (Int e = 0; e < size; ++e) {
+        a[e * lanes + l] = point < points ? blocks[point * size + e] : (e % (dof + 1) == 0 ? 1.0 : 0.0);
+      }
+    }
+    singular = FactorTile(dof, a, &pivots[t * dof * lanes]) || singular;
+  }
+
+  if (singular) {
+    PetscCallThrow(PETSC_ERR_MAT_LU_ZRPVT);
+  }
+}
+
+void PointBlockSolver::Solve(const Scalar* rhs, Scalar* solution) const {
+  Int tiles = (points + lanes - 1) / lanes;
+  Int size = dof * dof;
+
+  #pragma omp parallel
+  {
+    std::vector<Scalar> x(dof * lanes);
+
+    #pragma omp for schedule(static)
+    for (Int t = 0; t < tiles; ++t) {
+      Int count = std::min(lanes, points - t * lanes);
+      const Scalar* in = &rhs[t * lanes * dof];
+      Scalar* out = &solution[t * lanes * dof];
+
+      for (Int l = 0; l < lanes; ++l) {
+        for (Int r = 0; r < dof; ++r) {
+          x[r * lanes + l] = l < count ? in[l * dof + r] : 0.0;
+        }
+      }
+
+      SolveTile(dof, &factors[t * size * lanes], &pivots[t * dof * lanes], x.data());
+
+      for (Int l = 0; l < count; ++l) {
+        for (Int r = 0; r < dof; ++r) {
+          out[l * dof + r] = x[r * lanes + l];
+        }
+      }
+    }
+  }
+}
+
+void PointBlockSolver::Solve(const Vec& rhs, Vec& solution) const {
+  if (rhs.GetLocalSize() != dof * points || solution.GetLocalSize() != dof * points) {
+    PetscCallThrow(PETSC_ERR_ARG_SIZ);
+  }
+  auto in = rhs.GetArrayRead();
+  auto out = solution.GetArray(Write);
+  Solve(in, out);
+}
+
+Int PointBlockSolver::GetDof() const {
+  return dof;
+}
+
+Int PointBlockSolver::GetNumPoints() const {
+  return points;
+}
+
+void PointBlockSolver::SetAsPreconditioner(KSP& ksp) const {
+  PC pc;
+  PetscCallThrow(KSPGetPC(ksp, &pc));
+  PetscCallThrow(PCSetType(pc, PCSHELL));
+  PetscCallThrow(PCShellSetContext(pc, const_cast<PointBlockSolver*>(this)));
+  PetscCallThrow(PCShellSetApply(pc, ApplyPointBlock));
+  PetscCallThrow(PCShellSetName(pc, "point-block"));
+}
+
+}
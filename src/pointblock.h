@@ -0,0 +1,51 @@
+#ifndef SRC_POINTBLOCK_H
+#define SRC_POINTBLOCK_H
+
+#include <vector>
+
+#include <petscksp.h>
+
+#include "exception.h"
+#include "utils.h"
+#include "vec.h"
+#include "ksp.h"
+
+namespace Petsc {
+
+/// @brief Batched solver of independent dense `dof x dof` systems, one per grid point.
+/// Points are factored in tiles of `lanes` points stored as structure-of-arrays,
+/// so that the LU factorization with partial pivoting is vectorized across points.
+class PointBlockSolver {
+ public:
+  static constexpr Int lanes = 8;
+
+  PointBlockSolver(Int dof);
+  PETSC_NO_COPY_POLICY(PointBlockSolver);
+
+  /// @param blocks Row-major `dof x dof` blocks, one after another in the order of points
+  void Factor(Int points, const Scalar* blocks);
+
+  /// @brief Solves the systems of all points, `rhs` and `solution` are DOF-interlaced and may alias
+  void Solve(const Scalar* rhs, Scalar* solution) const;
+  void Solve(const Vec& rhs, Vec& solution) const;
+
+  Int GetDof() const;
+  Int GetNumPoints() const;
+
+  /// @brief Uses the factored blocks as a point-block Jacobi preconditioner of the local points
+  /// @note The solver should outlive the preconditioner of the `ksp`
+  void SetAsPreconditioner(KSP& ksp) const;
+
+ private:
+  Int dof;
+  Int points = 0;
+
+  /// @brief LU factors, `[tile][row][col][lane]`, inverted diagonal of U
+  std::vector<Scalar> factors;
+  /// @brief Pivot rows, `[tile][row][lane]`
+  std::vector<Int> pivots;
+};
+
+}
+
+#endif // SRC_POINTBLOCK_H
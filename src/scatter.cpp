@@ -0,0 +1,184 @@
+#include "scatter.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace Petsc {
+
+namespace {
+
+/// @brief Plans by the communicator and the layouts, identities and states of the arguments. The
+/// communicator is the PETSc inner one of the vectors, which the cached plan keeps alive.
+std::map<std::pair<MPI_Comm, std::vector<Int64>>, _p_PetscSF*> scatterCache;
+bool scatterCacheRegistered = false;
+
+PetscErrorCode DestroyScatterCache() {
+  PetscFunctionBeginUser;
+  for (auto& [key, scatter] : scatterCache) {
+    PetscCall(VecScatterDestroy(&scatter));
+  }
+  scatterCache.clear();
+  scatterCacheRegistered = false;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+void AppendLayout(std::vector<Int64>& key, const Vec& vec) {
+  auto [start, end] = vec.GetOwnershipRange();
+  key.insert(key.end(), {vec.GetSize(), start, end});
+}
+
+/// @brief Positions of the index set identities in the keys
+constexpr std::size_t identityPositions[] = {6, 8};
+
+void AppendIdentity(std::vector<Int64>& key, const IS* is) {
+  if (!is) {
+    key.insert(key.end(), {-1, -1});
+    return;
+  }
+  PetscObjectId id;
+  PetscObjectState state;
+  PetscCallThrow(PetscObjectGetId(*is, &id));
+  PetscCallThrow(PetscObjectStateGet(*is, &state));
+  key.insert(key.end(), {(Int64)id, (Int64)state});
+}
+
+/// @brief Drops the plans of an index set when it is destroyed
+PetscErrorCode EvictIS(void* ctx) {
+  PetscFunctionBeginUser;
+  Int64 id = (Int64)(std::uintptr_t)ctx;
+  for (auto it = scatterCache.begin(); it != scatterCache.end();) {
+    const auto& layout = it->first.second;
+    if (layout[identityPositions[0]] == id || layout[identityPositions[1]] == id) {
+      PetscCall(VecScatterDestroy(&it->second));
+      it = scatterCache.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/// @brief Composes a container on the index set, which evicts its plans on destruction
+void WatchIS(const IS* is) {
+  constexpr const char* key = "Petsc::Scatter::FromCache";
+  PetscObject watcher = nullptr;
+  PetscCallThrow(PetscObjectQuery(*is, key, &watcher));
+  if (watcher) {
+    return;
+  }
+
+  PetscObjectId id;
+  PetscContainer container;
+  PetscCallThrow(PetscObjectGetId(*is, &id));
+  PetscCallThrow(PetscContainerCreate(PETSC_COMM_SELF, &container));
+  PetscCallThrow(PetscContainerSetPointer(container, (void*)(std::uintptr_t)id));
+  PetscCallThrow(PetscContainerSetUserDestroy(container, EvictIS));
+  PetscCallThrow(PetscObjectCompose(*is, key, (PetscObject)container));
+  PetscCallThrow(PetscContainerDestroy(&container));
+}
+
+/// @brief Communicator of the plan, the one of the parallel vector as in `VecScatterCreate()`
+MPI_Comm GetPlanComm(const Vec& from, const Vec& to) {
+  MPI_Comm comm = PetscObjectComm(from);
+  MPI_Comm other = PetscObjectComm(to);
+  MPIInt size, otherSize;
+  PetscCallMPIThrow(MPI_Comm_size(comm, &size));
+  PetscCallMPIThrow(MPI_Comm_size(other, &otherSize));
+  return otherSize > size ? other : comm;
+}
+
+}
+
+Scatter::Scatter(const Vec& from, const IS* ix, const Vec& to, const IS* iy) {
+  PetscCallThrow(VecScatterCreate(from, ix ? (_p_IS*)*ix : nullptr, to, iy ? (_p_IS*)*iy : nullptr, &that));
+}
+
+/* static */ Scatter Scatter::Create(const Vec& from, const IS& ix, const Vec& to, const IS& iy) {
+  return Scatter(from, &ix, to, &iy);
+}
+
+/* static */ Scatter Scatter::FromCache(const Vec& from, const IS* ix, const Vec& to, const IS* iy) {
+  if (!scatterCacheRegistered) {
+    PetscCallThrow(PetscRegisterFinalize(DestroyScatterCache));
+    scatterCacheRegistered = true;
+  }
+
+  MPI_Comm comm = GetPlanComm(from, to);
+  std::vector<Int64> layout;
+  AppendLayout(layout, from);
+  AppendLayout(layout, to);
+  AppendIdentity(layout, ix);
+  AppendIdentity(layout, iy);
+
+  // Creation is collective, so the plan is reused only if it is found on every process
+  auto key = std::make_pair(comm, std::move(layout));
+  auto it = scatterCache.find(key);
+  int found = it != scatterCache.end();
+  PetscCallMPIThrow(MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_INT, MPI_LAND, comm));
+
+  if (!found) {
+    _p_PetscSF* created;
+    PetscCallThrow(VecScatterCreate(from, ix ? (_p_IS*)*ix : nullptr, to, iy ? (_p_IS*)*iy : nullptr, &created));
+    if (it != scatterCache.end()) {
+      PetscCallThrow(VecScatterDestroy(&it->second));
+      it->second = created;
+    }
+    else {
+      it = scatterCache.emplace(std::move(key), created).first;
+    }
+
+    for (const IS* is : {ix, iy}) {
+      if (is) {
+        WatchIS(is);
+      }
+    }
+  }
+
+  Scatter scatter;
+  PetscCallThrow(PetscObjectReference((PetscObject)it->second));
+  scatter.that = it->second;
+  return scatter;
+}
+
+Scatter::Transfer Scatter::Begin(const Vec& x, Vec& y, InsertMode mode, ScatterMode direction) const {
+  return Transfer(*this, x, y, mode, direction);
+}
+
+void Scatter::Apply(const Vec& x, Vec& y, InsertMode mode, ScatterMode direction) const {
+  PetscCallThrow(VecScatterBegin(that, x, y, mode, direction));
+  PetscCallThrow(VecScatterEnd(that, x, y, mode, direction));
+}
+
+void Scatter::View(PetscViewer viewer) const {
+  PetscCallThrow(VecScatterView(that, viewer));
+}
+
+void Scatter::Destroy() {
+  PetscCallThrow(VecScatterDestroy(&that));
+}
+
+Scatter::~Scatter() noexcept(false) {
+  Destroy();
+}
+
+
+Scatter::Transfer::Transfer(const Scatter& scatter, const Vec& x, Vec& y, InsertMode mode, ScatterMode direction)
+    : scatter(scatter), x(x), y(y), mode(mode), direction(direction) {
+  PetscCallThrow(VecScatterBegin(scatter, x, y, mode, direction));
+}
+
+void Scatter::Transfer::End() {
+  if (finished) {
+    return;
+  }
+  finished = true;
+  PetscCallThrow(VecScatterEnd(scatter, x, y, mode, direction));
+}
+
+Scatter::Transfer::~Transfer() noexcept(false) {
+  End();
+}
+
+}
@@ -0,0 +1,67 @@
+#ifndef SRC_SCATTER_H
+#define SRC_SCATTER_H
+
+#include <petscvec.h>
+
+#include "exception.h"
+#include "utils.h"
+#include "vec.h"
+#include "is.h"
+
+namespace Petsc {
+
+/// @brief Communication plan moving `from[ix]` into `to[iy]`, null index sets take the whole vector
+class Scatter {
+ public:
+  Scatter() = default;
+  Scatter(const Vec& from, const IS* ix, const Vec& to, const IS* iy);
+  PETSC_DEFAULT_COPY_POLICY(Scatter);
+
+  static Scatter Create(const Vec& from, const IS& ix, const Vec& to, const IS& iy);
+
+  /// @brief Shares the plan between the calls with the same layouts of vectors and the same,
+  /// unmodified index sets, so it is set up once per run. Plans are dropped with their index sets,
+  /// the cache is cleared by `PetscFinalize()`.
+  static Scatter FromCache(const Vec& from, const IS* ix, const Vec& to, const IS* iy);
+
+  /// @brief Transfer in flight, started on construction and finished by `End()` or destruction
+  class Transfer;
+  Transfer Begin(const Vec& x, Vec& y, InsertMode mode, ScatterMode direction = SCATTER_FORWARD) const;
+  void Apply(const Vec& x, Vec& y, InsertMode mode, ScatterMode direction = SCATTER_FORWARD) const;
+
+  void View(PetscViewer viewer) const;
+
+  void Destroy();
+  ~Scatter() noexcept(false);
+
+  /// @brief Conversion to PETSc vector scatter
+  operator _p_PetscSF*() const { return that; }
+  operator _p_PetscSF**() { return &that; }
+  operator _p_PetscObject*() const { return reinterpret_cast<PetscObject>(that); }
+  operator _p_PetscObject**() { return reinterpret_cast<PetscObject*>(&that); }
+
+ private:
+  _p_PetscSF* that = nullptr;
+};
+
+class Scatter::Transfer {
+ public:
+  Transfer(const Scatter& scatter, const Vec& x, Vec& y, InsertMode mode, ScatterMode direction);
+  ~Transfer() noexcept(false);
+  PETSC_NO_COPY_POLICY(Transfer);
+
+  void End();
+
+ private:
+  const Scatter& scatter;
+  const Vec& x;
+  Vec& y;
+  InsertMode mode;
+  ScatterMode direction;
+
+  bool finished = false;
+};
+
+}
+
+#endif // SRC_SCATTER_H
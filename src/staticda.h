@@ -0,0 +1,61 @@
+#ifndef SRC_STATICDA_H
+#define SRC_STATICDA_H
+
+#include <utility>
+
+#include "dmda.h"
+
+#include "exception.h"
+#include "utils.h"
+
+namespace Petsc {
+
+/// @brief DA with the dimension, the number of components and the stencil width fixed
+/// at compile time. Sizes and corners are cached by `SetUp()`, so they are not queried
+/// from PETSc on each call, typed views and loops know their extents statically.
+template<Int Dim, Int Dof, Int S>
+class StaticDA : public DA {
+  static_assert(Dim >= 1 && Dim <= 3, "Grid dimension should be 1, 2 or 3");
+  static_assert(Dof > 0, "Number of components should be positive");
+  static_assert(S >= 0, "Stencil width should be non-negative");
+
+ public:
+  static constexpr Int dim = Dim;
+  static constexpr Int dof = Dof;
+  static constexpr Int stencilWidth = S;
+
+  /// @note Components of the arguments above `Dim` are ignored
+  StaticDA(Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs = PETSC_DECIDE, Three<const Int*> ranges = nullptr);
+  StaticDA(MPI_Comm comm, Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs = PETSC_DECIDE, Three<const Int*> ranges = nullptr);
+  PETSC_NO_COPY_POLICY(StaticDA);
+
+  /// @brief Sets up the DA, verifies that PETSc layout matches the template parameters
+  void SetUp();
+
+  static constexpr Int GetDof() { return Dof; }
+  static constexpr Int GetStencilWidth() { return S; }
+  Int3 GetSizes() const { return sizes; }
+  std::pair<Int3, Int3> GetCorners() const { return corners; }
+  std::pair<Int3, Int3> GetGhostCorners() const { return ghostCorners; }
+
+  template<bool isConst> using View = BorrowedView<Dim, Dof, isConst>;
+  View<false> GetView(Vec& vec, GetArrayType type = Default) const;
+  View<true> GetView(const Vec& vec) const;
+
+  /// @brief Calls `f(i)`, `f(j, i)` or `f(k, j, i)` for each owned point, `i` is the innermost
+  template<typename F> void ForEach(F&& f) const;
+
+  /// @brief Calls `f(c)` for each component with `c` as `std::integral_constant`, fully unrolled
+  template<typename F> static constexpr void ForEachComponent(F&& f);
+
+ private:
+  Int3 sizes = 0;
+  std::pair<Int3, Int3> corners;
+  std::pair<Int3, Int3> ghostCorners;
+};
+
+}
+
+#include "staticda.inl"
+
+#endif // SRC_STATICDA_H
@@ -0,0 +1,97 @@
+#include "staticda.h"
+
+namespace Petsc {
+
+template<Int Dim, Int Dof, Int S>
+StaticDA<Dim, Dof, S>::StaticDA(Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs, Three<const Int*> ranges)
+    : StaticDA(PETSC_COMM_WORLD, boundary, type, global, procs, ranges) {}
+
+template<Int Dim, Int Dof, Int S>
+StaticDA<Dim, Dof, S>::StaticDA(MPI_Comm comm, Three<BoundaryType> boundary, StencilType type, Int3 global, Int3 procs, Three<const Int*> ranges)
+    : DA(comm) {
+  // The same configuration sequence as in `DMDACreate3d()` and its lower dimensional versions
+  if constexpr (Dim < 3) {
+    boundary.z = DM_BOUNDARY_NONE;
+    global.z = 1;
+    procs.z = PETSC_DECIDE;
+    ranges.z = nullptr;
+  }
+  if constexpr (Dim < 2) {
+    boundary.y = DM_BOUNDARY_NONE;
+    global.y = 1;
+    procs.y = PETSC_DECIDE;
+    ranges.y = nullptr;
+  }
+
+  SetDimension(Dim);
+  SetSizes(global);
+  SetNumProcs(procs);
+  SetBoundaryType(boundary);
+  SetDof(Dof);
+  SetStencilType(type);
+  SetStencilWidth(S);
+  SetOwnershipRanges(ranges);
+}
+
+template<Int Dim, Int Dof, Int S>
+void StaticDA<Dim, Dof, S>::SetUp() {
+  DM::SetUp();
+
+  // Options may have changed the layout after the construction
+  if (GetDimension() != Dim || DA::GetDof() != Dof || DA::GetStencilWidth() != S) {
+    PetscCallThrow(PETSC_ERR_ARG_INCOMP);
+  }
+
+  sizes = DA::GetSizes();
+  corners = DA::GetCorners();
+  ghostCorners = DA::GetGhostCorners();
+}
+
+template<Int Dim, Int Dof, Int S>
+auto StaticDA<Dim, Dof, S>::GetView(Vec& vec, GetArrayType type) const -> View<false> {
+  if (!(type == Default || type == Write)) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+  return View<false>(corners, ghostCorners, Dof, vec, type);
+}
+
+template<Int Dim, Int Dof, Int S>
+auto StaticDA<Dim, Dof, S>::GetView(const Vec& vec) const -> View<true> {
+  return View<true>(corners, ghostCorners, Dof, vec, Read);
+}
+
+template<Int Dim, Int Dof, Int S>
+template<typename F>
+void StaticDA<Dim, Dof, S>::ForEach(F&& f) const {
+  auto [start, size] = corners;
+  Int3 end(start.x + size.x, start.y + size.y, start.z + size.z);
+
+  if constexpr (Dim == 1) {
+    for (Int i = start.x; i < end.x; ++i) {
+      f(i);
+    }
+  }
+  else if constexpr (Dim == 2) {
+    for (Int j = start.y; j < end.y; ++j) {
+    for (Int i = start.x; i < end.x; ++i) {
+      f(j, i);
+    }}
+  }
+  else {
+    for (Int k = start.z; k < end.z; ++k) {
+    for (Int j = start.y; j < end.y; ++j) {
+    for (Int i = start.x; i < end.x; ++i) {
+      f(k, j, i);
+    }}}
+  }
+}
+
+template<Int Dim, Int Dof, Int S>
+template<typename F>
+constexpr void StaticDA<Dim, Dof, S>::ForEachComponent(F&& f) {
+  [&]<Int... c>(std::integer_sequence<Int, c...>) {
+    (f(std::integral_constant<Int, c>{}), ...);
+  }(std::make_integer_sequence<Int, Dof>{});
+}
+
+}
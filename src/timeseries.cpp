@@ -0,0 +1,451 @@
+#include "timeseries.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <string>
+
+namespace Petsc {
+
+#ifdef PETSC_HAVE_MPIIO
+namespace {
+
+/// @brief Superblock: magic, version, last footer offset, last footer bytes, steps, scalar size, reserved
+constexpr Int64 seriesMagic = 0x50575453;
+constexpr Int64 seriesVersion = 1;
+constexpr Int64 superblockWords = 8;
+constexpr Int64 superblockBytes = superblockWords * sizeof(Int64);
+
+/// @brief Metadata is encoded big-endian byte by byte, so names need no swapping
+void Put(std::vector<char>& out, Int64 value) {
+  for (int b = 7; b >= 0; --b) {
+    out.emplace_back((char)((std::uint64_t)value >> (8 * b)));
+  }
+}
+
+void Put(std::vector<char>& out, std::string_view name) {
+  Put(out, (Int64)name.size());
+  out.insert(out.end(), name.begin(), name.end());
+}
+
+class Decoder {
+ public:
+  Decoder(const std::vector<char>& data) : at(data.data()), end(data.data() + data.size()) {}
+
+  Int64 Get() {
+    Check(8);
+    std::uint64_t value = 0;
+    for (int b = 0; b < 8; ++b) {
+      value = (value << 8) | (unsigned char)*at++;
+    }
+    return (Int64)value;
+  }
+
+  /// @brief Number of the following items, each of them takes at least a byte
+  Int64 GetCount() {
+    Int64 count = Get();
+    Check(count);
+    return count;
+  }
+
+  std::string GetName() {
+    Int64 size = Get();
+    Check(size);
+    std::string name(at, size);
+    at += size;
+    return name;
+  }
+
+ private:
+  void Check(Int64 size) {
+    if (size < 0 || end - at < size) {
+      PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+    }
+  }
+
+  const char* at;
+  const char* end;
+};
+
+/// @brief Links of a footer to the previous one, whose offset is 0 for the first footer
+struct FooterLink {
+  Int64 offset = 0;
+  Int64 bytes = 0;
+};
+
+/// @brief Encodes the names and steps added since the previous footer
+std::vector<char> EncodeIndex(const TimeSeriesIndex& index, Int firstName, Int firstStep, FooterLink previous) {
+  std::vector<char> out;
+  Put(out, previous.offset);
+  Put(out, previous.bytes);
+  Put(out, (Int64)firstName);
+  Put(out, (Int64)index.names.size() - firstName);
+  for (auto name = index.names.begin() + firstName; name != index.names.end(); ++name) {
+    Put(out, *name);
+  }
+  Put(out, (Int64)index.steps.size() - firstStep);
+  for (Int n = firstStep; n < (Int)index.steps.size(); ++n) {
+    const auto& step = index.steps[n];
+    Put(out, step.step);
+    Put(out, std::bit_cast<Int64>((double)step.time));
+    Put(out, (Int64)step.fields.size());
+    for (const auto& field : step.fields) {
+      Put(out, field.name);
+      Put(out, field.offset);
+      Put(out, field.size);
+    }
+  }
+  return out;
+}
+
+/// @brief Decodes the names and steps of a footer, the names of the fields count from `firstName`
+TimeSeriesIndex DecodeIndex(const std::vector<char>& data, Int64& firstName, FooterLink& previous) {
+  TimeSeriesIndex index;
+  Decoder decoder(data);
+  previous.offset = decoder.Get();
+  previous.bytes = decoder.Get();
+  firstName = decoder.Get();
+  index.names.resize(decoder.GetCount());
+  for (auto& name : index.names) {
+    name = decoder.GetName();
+  }
+  index.steps.resize(decoder.GetCount());
+  for (auto& step : index.steps) {
+    step.step = decoder.Get();
+    step.time = (Real)std::bit_cast<double>(decoder.Get());
+    step.fields.resize(decoder.GetCount());
+    for (auto& field : step.fields) {
+      field.name = decoder.Get();
+      field.offset = decoder.Get();
+      field.size = decoder.Get();
+      if (field.name < 0 || firstName < 0 || field.name >= firstName + (Int64)index.names.size()) {
+        PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+      }
+    }
+  }
+  return index;
+}
+
+/// @brief Sets the collective buffering hints for large contiguous transfers
+void SetHints(MPI_File fd, Int bufferSize) {
+  std::string size = std::to_string(bufferSize);
+  MPI_Info info;
+  PetscCallMPIThrow(MPI_Info_create(&info));
+  PetscCallMPIThrow(MPI_Info_set(info, "romio_cb_write", "enable"));
+  PetscCallMPIThrow(MPI_Info_set(info, "romio_cb_read", "enable"));
+  PetscCallMPIThrow(MPI_Info_set(info, "cb_buffer_size", size.c_str()));
+  PetscCallMPIThrow(MPI_File_set_info(fd, info));
+  PetscCallMPIThrow(MPI_Info_free(&info));
+  PetscCallMPIThrow(MPI_File_set_view(fd, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL));
+}
+
+/// @brief Reads the superblock and follows the chain of footers back to the first one, collective
+/// @param last Position of the last footer, the data of the next steps goes after it
+TimeSeriesIndex ReadIndex(MPI_File fd, FooterLink& last) {
+  std::vector<char> superblock(superblockBytes);
+  PetscCallMPIThrow(MPI_File_read_at_all(fd, 0, superblock.data(), (MPIInt)superblockBytes, MPI_BYTE, MPI_STATUS_IGNORE));
+
+  Decoder decoder(superblock);
+  Int64 words[superblockWords];
+  for (auto& word : words) {
+    word = decoder.Get();
+  }
+  if (words[0] != seriesMagic || words[1] != seriesVersion || words[5] != (Int64)sizeof(Scalar)) {
+    PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+  }
+  last = {words[2], words[3]};
+
+  // Footers are read from the last one, each of them lies before the next one
+  std::vector<std::pair<Int64, TimeSeriesIndex>> parts;
+  Int64 steps = 0;
+  FooterLink link = last;
+  do {
+    if (link.offset < superblockBytes || link.bytes < 0 || link.bytes > PETSC_MPI_INT_MAX) {
+      PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+    }
+    std::vector<char> footer(link.bytes);
+    PetscCallMPIThrow(MPI_File_read_at_all(fd, link.offset, footer.data(), (MPIInt)link.bytes, MPI_BYTE, MPI_STATUS_IGNORE));
+
+    Int64 firstName;
+    FooterLink previous;
+    auto part = DecodeIndex(footer, firstName, previous);
+    steps += (Int64)part.steps.size();
+    if (steps > words[4] || (previous.offset != 0 && previous.offset >= link.offset)) {
+      PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+    }
+    parts.emplace_back(firstName, std::move(part));
+    link = previous;
+  } while (link.offset != 0);
+
+  TimeSeriesIndex index;
+  for (auto part = parts.rbegin(); part != parts.rend(); ++part) {
+    if (part->first != (Int64)index.names.size()) {
+      PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+    }
+    auto& [names, partSteps] = part->second;
+    index.names.insert(index.names.end(), std::make_move_iterator(names.begin()), std::make_move_iterator(names.end()));
+    index.steps.insert(index.steps.end(), std::make_move_iterator(partSteps.begin()), std::make_move_iterator(partSteps.end()));
+  }
+  if ((Int64)index.steps.size() != words[4]) {
+    PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+  }
+  return index;
+}
+
+/// @brief Writes the footer at `offset` and then the superblock pointing to it, from the first process
+void WriteIndex(MPI_File fd, MPIInt rank, const std::vector<char>& footer, Int64 offset, Int64 steps) {
+  if (footer.size() > PETSC_MPI_INT_MAX) {
+    PetscCallThrow(PETSC_ERR_SUP);
+  }
+  MPIInt bytes = rank == 0 ? (MPIInt)footer.size() : 0;
+  PetscCallMPIThrow(MPI_File_write_at_all(fd, offset, footer.data(), bytes, MPI_BYTE, MPI_STATUS_IGNORE));
+  PetscCallMPIThrow(MPI_File_sync(fd));
+
+  std::vector<char> superblock;
+  for (Int64 word : {seriesMagic, seriesVersion, offset, (Int64)footer.size(), steps, (Int64)sizeof(Scalar), (Int64)0, (Int64)0}) {
+    Put(superblock, word);
+  }
+  bytes = rank == 0 ? (MPIInt)superblockBytes : 0;
+  PetscCallMPIThrow(MPI_File_write_at_all(fd, 0, superblock.data(), bytes, MPI_BYTE, MPI_STATUS_IGNORE));
+  PetscCallMPIThrow(MPI_File_sync(fd));
+}
+
+/// @brief Number of local entries as an MPI count
+MPIInt GetCount(Int count) {
+  if (count > PETSC_MPI_INT_MAX) {
+    PetscCallThrow(PETSC_ERR_SUP);
+  }
+  return (MPIInt)count;
+}
+
+}
+
+TimeSeriesWriter::TimeSeriesWriter(MPI_Comm comm, std::string_view filename, Bool append, Int bufferSize) {
+  // The index of an existing file is read back, which the write-only modes of the viewer do not allow
+  std::string name(filename);
+  PetscCallMPIThrow(MPI_File_open(comm, name.c_str(), MPI_MODE_CREATE | MPI_MODE_RDWR, MPI_INFO_NULL, &fd));
+  try {
+    SetHints(fd, bufferSize);
+    PetscCallMPIThrow(MPI_Comm_rank(comm, &rank));
+
+    MPI_Offset size = 0;
+    if (append) {
+      PetscCallMPIThrow(MPI_File_get_size(fd, &size));
+    }
+    else {
+      PetscCallMPIThrow(MPI_File_set_size(fd, 0));
+    }
+
+    if (size > 0) {
+      FooterLink last;
+      index = ReadIndex(fd, last);
+      committed = (Int)index.steps.size();
+      committedNames = (Int)index.names.size();
+      footerOffset = last.offset;
+      footerBytes = last.bytes;
+      cursor = footerOffset + footerBytes;
+    }
+    else {
+      // A new file is valid from the start, with an empty footer
+      cursor = superblockBytes;
+      WriteFooter();
+    }
+  }
+  catch (...) {
+    MPI_File_close(&fd);
+    throw;
+  }
+}
+
+void TimeSeriesWriter::BeginStep(Int step, Real time) {
+  if (inStep) {
+    PetscCallThrow(PETSC_ERR_ORDER);
+  }
+  // Step numbers identify the steps for the readers, also across appending runs
+  if (std::any_of(index.steps.begin(), index.steps.end(), [step](const auto& s) { return s.step == step; })) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+  index.steps.push_back({step, time, {}});
+  inStep = true;
+}
+
+void TimeSeriesWriter::WriteField(std::string_view name, const Vec& vec) {
+  if (!inStep) {
+    PetscCallThrow(PETSC_ERR_ORDER);
+  }
+
+  auto found = std::find(index.names.begin(), index.names.end(), name);
+  Int id = (Int)(found - index.names.begin());
+  if (found == index.names.end()) {
+    index.names.emplace_back(name);
+  }
+  auto& fields = index.steps.back().fields;
+  if (std::any_of(fields.begin(), fields.end(), [&](const auto& field) { return field.name == id; })) {
+    PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  }
+
+  Int size = vec.GetSize();
+  auto [start, end] = vec.GetOwnershipRange();
+  std::vector<Scalar> values(end - start);
+  {
+    auto array = vec.GetArrayRead();
+    std::copy((const Scalar*)array, (const Scalar*)array + (end - start), values.data());
+  }
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  PetscCallThrow(PetscByteSwap(values.data(), PETSC_SCALAR, end - start));
+#endif
+
+  MPI_Offset at = cursor + (MPI_Offset)start * sizeof(Scalar);
+  PetscCallMPIThrow(MPI_File_write_at_all(fd, at, values.data(), GetCount(end - start), MPIU_SCALAR, MPI_STATUS_IGNORE));
+
+  fields.push_back({id, cursor, size});
+  cursor += (Int64)size * sizeof(Scalar);
+}
+
+void TimeSeriesWriter::WriteField(std::string_view name, const DA& da, const Vec& global) {
+  auto natural = da.CreateNaturalVector();
+  da.GlobalToNatural(global, INSERT_VALUES, natural);
+  WriteField(name, natural);
+}
+
+void TimeSeriesWriter::EndStep() {
+  if (!inStep) {
+    PetscCallThrow(PETSC_ERR_ORDER);
+  }
+  inStep = false;
+}
+
+void TimeSeriesWriter::Commit() {
+  if (inStep) {
+    PetscCallThrow(PETSC_ERR_ORDER);
+  }
+  if (committed == (Int)index.steps.size()) {
+    return;
+  }
+
+  // The footer goes after the data, the previous one stays valid until the superblock is replaced
+  WriteFooter();
+}
+
+void TimeSeriesWriter::WriteFooter() {
+  auto data = EncodeIndex(index, committedNames, committed, {footerOffset, footerBytes});
+  WriteIndex(fd, rank, data, cursor, (Int64)index.steps.size());
+
+  footerOffset = cursor;
+  footerBytes = (Int64)data.size();
+  cursor += footerBytes;
+  committed = (Int)index.steps.size();
+  committedNames = (Int)index.names.size();
+}
+
+void TimeSeriesWriter::Close() {
+  if (fd == MPI_FILE_NULL) {
+    return;
+  }
+  if (inStep) {
+    EndStep();
+  }
+  Commit();
+  PetscCallMPIThrow(MPI_File_close(&fd));
+}
+
+TimeSeriesWriter::~TimeSeriesWriter() noexcept(false) {
+  Close();
+}
+
+TimeSeriesReader::TimeSeriesReader(MPI_Comm comm, std::string_view filename, Int bufferSize)
+    : viewer(comm, std::string(filename), FILE_MODE_READ) {
+  viewer.SetUseMPIIO(PETSC_TRUE);
+  viewer.SetSkipInfo(PETSC_TRUE);
+  fd = viewer.GetMPIIODescriptor();
+  SetHints(fd, bufferSize);
+
+  FooterLink last;
+  index = ReadIndex(fd, last);
+  for (Int n = 0; n < (Int)index.steps.size(); ++n) {
+    if (!positions.emplace(index.steps[n].step, n).second) {
+      PetscCallThrow(PETSC_ERR_FILE_UNEXPECTED);
+    }
+  }
+}
+
+Int TimeSeriesReader::GetStep(Int n) const {
+  if (n < 0 || n >= GetNumSteps()) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+  return index.steps[n].step;
+}
+
+Real TimeSeriesReader::GetTime(Int n) const {
+  if (n < 0 || n >= GetNumSteps()) {
+    PetscCallThrow(PETSC_ERR_ARG_OUTOFRANGE);
+  }
+  return index.steps[n].time;
+}
+
+Int TimeSeriesReader::FindStep(Int step) const {
+  auto found = positions.find(step);
+  return found == positions.end() ? -1 : found->second;
+}
+
+std::vector<std::string> TimeSeriesReader::GetFieldNames(Int n) const {
+  GetStep(n);
+  std::vector<std::string> names;
+  for (const auto& field : index.steps[n].fields) {
+    names.emplace_back(index.names[field.name]);
+  }
+  return names;
+}
+
+Int TimeSeriesReader::GetFieldSize(Int n, std::string_view name) const {
+  return GetField(n, name).size;
+}
+
+const TimeSeriesIndex::Field& TimeSeriesReader::GetField(Int n, std::string_view name) const {
+  GetStep(n);
+  for (const auto& field : index.steps[n].fields) {
+    if (index.names[field.name] == name) {
+      return field;
+    }
+  }
+  PetscCallThrow(PETSC_ERR_ARG_WRONG);
+  return index.steps[n].fields.front();
+}
+
+void TimeSeriesReader::ReadField(Int n, std::string_view name, Vec& vec) {
+  const auto& field = GetField(n, name);
+  if (field.size != vec.GetSize()) {
+    PetscCallThrow(PETSC_ERR_ARG_SIZ);
+  }
+
+  auto [start, end] = vec.GetOwnershipRange();
+  auto array = vec.GetArray(Write);
+  Scalar* values = array;
+
+  MPI_Offset at = field.offset + (MPI_Offset)start * sizeof(Scalar);
+  PetscCallMPIThrow(MPI_File_read_at_all(fd, at, values, GetCount(end - start), MPIU_SCALAR, MPI_STATUS_IGNORE));
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  PetscCallThrow(PetscByteSwap(values, PETSC_SCALAR, end - start));
+#endif
+}
+
+void TimeSeriesReader::ReadField(Int n, std::string_view name, const DA& da, Vec& global) {
+  auto natural = da.CreateNaturalVector();
+  ReadField(n, name, natural);
+  da.NaturalToGlobal(natural, INSERT_VALUES, global);
+}
+
+void TimeSeriesReader::Close() {
+  if (fd == MPI_FILE_NULL) {
+    return;
+  }
+  fd = MPI_FILE_NULL;
+  viewer.Destroy();
+}
+
+TimeSeriesReader::~TimeSeriesReader() noexcept(false) {
+  Close();
+}
+#endif
+
+}
@@ -0,0 +1,124 @@
+#ifndef SRC_TIMESERIES_H
+#define SRC_TIMESERIES_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "binary.h"
+#include "dmda.h"
+
+#include "exception.h"
+#include "utils.h"
+#include "vec.h"
+
+namespace Petsc {
+
+#ifdef PETSC_HAVE_MPIIO
+/// @brief Positions of the fields of each step, stored in the footer of a time series file
+struct TimeSeriesIndex {
+  struct Field {
+    /// @brief Position in `names`
+    Int name;
+    Int64 offset;
+    Int size;
+  };
+
+  struct Step {
+    Int step;
+    Real time;
+    std::vector<Field> fields;
+  };
+
+  std::vector<std::string> names;
+  std::vector<Step> steps;
+};
+
+/// @brief Appends the fields of many steps into a single file with MPI-IO. The file starts with a
+/// superblock that points to the last footer. Steps are appended after it, and `Commit()` writes a
+/// new footer with the index of the steps since the previous commit and then the superblock, so a
+/// crash leaves the file with the steps of the previous commit.
+/// @note A commit costs two syncs and a footer of the new steps, which links to the previous one.
+/// Readers follow the links when opening, so the cadence of commits trades the loss on a crash for
+/// the time to open the file.
+class TimeSeriesWriter {
+ public:
+  /// @param append Continues the series of an existing file instead of creating a new one
+  /// @param bufferSize Collective buffer size hint of the MPI-IO implementation in bytes
+  TimeSeriesWriter(MPI_Comm comm, std::string_view filename, Bool append = PETSC_FALSE, Int bufferSize = 16 << 20);
+  PETSC_NO_COPY_POLICY(TimeSeriesWriter);
+
+  /// @brief Starts a step, whose number must not be in the file already
+  void BeginStep(Int step, Real time);
+  /// @brief Appends the vector in its global ordering, collective
+  void WriteField(std::string_view name, const Vec& vec);
+  /// @brief Appends the DA vector in the natural ordering, as `Vec::View()` does
+  void WriteField(std::string_view name, const DA& da, const Vec& global);
+  void EndStep();
+
+  /// @brief Makes the finished steps visible to readers, collective. Steps are only committed
+  /// explicitly and on `Close()`.
+  void Commit();
+
+  /// @brief Ends the current step and commits
+  void Close();
+  ~TimeSeriesWriter() noexcept(false);
+
+ private:
+  /// @brief Writes the footer of the uncommitted steps at the cursor and points the superblock to it
+  void WriteFooter();
+
+  MPI_File fd = MPI_FILE_NULL;
+  MPIInt rank;
+
+  TimeSeriesIndex index;
+  Int committed = 0;
+  Int committedNames = 0;
+  bool inStep = false;
+
+  /// @brief Last footer in the file
+  Int64 footerOffset = 0;
+  Int64 footerBytes = 0;
+
+  /// @brief End of the data, where the next field or footer is written
+  Int64 cursor;
+};
+
+/// @brief Random access to the steps and fields of a file of `TimeSeriesWriter`
+class TimeSeriesReader {
+ public:
+  TimeSeriesReader(MPI_Comm comm, std::string_view filename, Int bufferSize = 16 << 20);
+  PETSC_NO_COPY_POLICY(TimeSeriesReader);
+
+  Int GetNumSteps() const { return (Int)index.steps.size(); }
+  Int GetStep(Int n) const;
+  Real GetTime(Int n) const;
+  /// @brief Position of the step number in the file, `-1` if it was not written
+  Int FindStep(Int step) const;
+
+  std::vector<std::string> GetFieldNames(Int n) const;
+  Int GetFieldSize(Int n, std::string_view name) const;
+
+  /// @brief Reads the field of the `n`-th step into the vector of any partitioning, collective
+  void ReadField(Int n, std::string_view name, Vec& vec);
+  /// @brief Reads the field written from a DA vector, which is in the natural ordering
+  void ReadField(Int n, std::string_view name, const DA& da, Vec& global);
+
+  void Close();
+  ~TimeSeriesReader() noexcept(false);
+
+ private:
+  const TimeSeriesIndex::Field& GetField(Int n, std::string_view name) const;
+
+  Binary viewer;
+  MPI_File fd = MPI_FILE_NULL;
+
+  TimeSeriesIndex index;
+  std::unordered_map<Int, Int> positions;
+};
+#endif
+
+}
+
+#endif // SRC_TIMESERIES_H
@@ -2,8 +2,11 @@
 
 namespace Petsc {
 
-Vec::Vec(Int localSize, Int globalSize, std::string_view name) {
-  PetscCallThrow(VecCreate(PETSC_COMM_WORLD, &that));
+Vec::Vec(Int localSize, Int globalSize, std::string_view name)
+    : Vec(PETSC_COMM_WORLD, localSize, globalSize, name) {}
+
+Vec::Vec(MPI_Comm comm, Int localSize, Int globalSize, std::string_view name) {
+  PetscCallThrow(VecCreate(comm, &that));
   PetscCallThrow(VecSetSizes(that, localSize, globalSize));
   PetscCallThrow(VecSetType(that, VECSTANDARD)); // seq on one process and mpi on multiple
   PetscCallThrow(VecSetUp(that));                // explicitly setting up internal vec structures
@@ -13,15 +16,27 @@ Vec::Vec(Int localSize, Int globalSize, std::string_view name) {
 }
 
 /* static */ Vec Vec::FromLocals(Int localSize, std::string_view name) {
-  return FromOptions(localSize, PETSC_DETERMINE, name);
+  return FromOptions(PETSC_COMM_WORLD, localSize, PETSC_DETERMINE, name);
+}
+
+/* static */ Vec Vec::FromLocals(MPI_Comm comm, Int localSize, std::string_view name) {
+  return FromOptions(comm, localSize, PETSC_DETERMINE, name);
 }
 
 /* static */ Vec Vec::FromGlobals(Int globalSize, std::string_view name) {
-  return FromOptions(PETSC_DECIDE, globalSize, name);
+  return FromOptions(PETSC_COMM_WORLD, PETSC_DECIDE, globalSize, name);
+}
+
+/* static */ Vec Vec::FromGlobals(MPI_Comm comm, Int globalSize, std::string_view name) {
+  return FromOptions(comm, PETSC_DECIDE, globalSize, name);
 }
 
 /* static */ Vec Vec::FromOptions(Int localSize, Int globalSize, std::string_view name) {
-  Vec vec(localSize, globalSize, name);
+  return FromOptions(PETSC_COMM_WORLD, localSize, globalSize, name);
+}
+
+/* static */ Vec Vec::FromOptions(MPI_Comm comm, Int localSize, Int globalSize, std::string_view name) {
+  Vec vec(comm, localSize, globalSize, name);
   PetscCallThrow(VecSetFromOptions(vec));
   return vec;
 }
@@ -175,6 +190,14 @@ void Vec::AssemblyEnd() {
   PetscCallThrow(VecAssemblyEnd(that));
 }
 
+void Vec::StrideGather(Int start, Vec& s, InsertMode mode) const {
+  PetscCallThrow(VecStrideGather(that, start, s, mode));
+}
+
+void Vec::StrideScatter(Int start, const Vec& s, InsertMode mode) {
+  PetscCallThrow(VecStrideScatter(s, start, that, mode));
+}
+
 Vec::BorrowedArray Vec::GetArray(GetArrayType type) {
   if (!(type == Default || type == Write)) {
     PetscCallThrow(PETSC_ERR_ARG_WRONG);
@@ -21,11 +21,15 @@ class Vec {
  public:
   Vec() = default;
   Vec(Int localSize, Int globalSize, std::string_view name = {});
+  Vec(MPI_Comm comm, Int localSize, Int globalSize, std::string_view name = {});
   PETSC_DEFAULT_COPY_POLICY(Vec);
 
   static Vec FromLocals(Int localSize, std::string_view name = {});
+  static Vec FromLocals(MPI_Comm comm, Int localSize, std::string_view name = {});
   static Vec FromGlobals(Int globalSize, std::string_view name = {});
+  static Vec FromGlobals(MPI_Comm comm, Int globalSize, std::string_view name = {});
   static Vec FromOptions(Int localSize, Int globalSize, std::string_view name = {});
+  static Vec FromOptions(MPI_Comm comm, Int localSize, Int globalSize, std::string_view name = {});
 
   Vec Duplicate() const;
   Vec Copy() const;
@@ -60,6 +64,10 @@ class Vec {
   void AssemblyBegin();
   void AssemblyEnd();
 
+  /// @brief Moves the component `start` of each block of the interlaced vector into/from `s`
+  void StrideGather(Int start, Vec& s, InsertMode mode) const;
+  void StrideScatter(Int start, const Vec& s, InsertMode mode);
+
   using BorrowedArray = BasicBorrowedArray<false>;
   using ConstBorrowedArray = BasicBorrowedArray<true>;
 
@@ -0,0 +1,62 @@
+#include <context.h>
+#include <exception.h>
+#include <binary.h>
+#include <mapped.h>
+#include <vec.h>
+
+constexpr const char* output_filename = "ex10_out";
+
+void fill_vector(Petsc::Vec& vec);
+
+int main(int argc, char** argv) {
+  using namespace Petsc;
+
+  try {
+    Context::Instance(&argc, &argv);
+
+    auto x = Petsc::Vec::FromGlobals(1000);
+    fill_vector(x);
+    {
+      auto viewer = Petsc::Binary::Open(PETSC_COMM_WORLD, output_filename, FILE_MODE_WRITE);
+      viewer.SetSkipInfo(PETSC_TRUE);
+      x.View(viewer);
+      x.View(viewer);
+    }
+    Real norm = x.Norm(NORM_INFINITY);
+
+    MPIInt rank;
+    PetscCallMPIThrow(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+
+    // Analysis tool on a single process, the file is mapped instead of loaded
+    if (rank == 0) {
+      Petsc::MappedBinaryFile file(output_filename);
+      Printf(PETSC_COMM_SELF, "Mapped %zu objects\n", file.GetNumObjects());
+
+      for (std::size_t n = 0; n < file.GetNumObjects(); ++n) {
+        auto values = file.GetValues(n);
+        auto view = file.GetVec(n);
+
+        Printf(PETSC_COMM_SELF, "  vector %zu: size %" PetscInt_FMT ", first %+1.2e, max(|a|) %1.2e, expected %1.2e\n",
+          n, view.GetSize(), (double)PetscRealPart(values[0]), (double)view.Norm(NORM_INFINITY), (double)norm);
+      }
+    }
+  }
+  catch (const Petsc::Exception& e) {
+    Printf(PETSC_COMM_WORLD, e.what());
+    PetscCallMPI(MPI_Abort(PETSC_COMM_WORLD, (MPIInt)e.code()));
+  }
+  catch (...) {
+    Printf(PETSC_COMM_WORLD, "Unkown exception captured!");
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+void fill_vector(Petsc::Vec& vec) {
+  auto [rstart, _] = vec.GetOwnershipRange();
+  auto arr = vec.GetArray();
+  for (auto it = arr.begin(); it != arr.end(); ++it) {
+    it.value() = rstart + it.index();
+  }
+}
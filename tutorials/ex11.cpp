@@ -0,0 +1,85 @@
+#include <cmath>
+
+#include <context.h>
+#include <exception.h>
+#include <dmda.h>
+#include <timeseries.h>
+
+constexpr const char* output_filename = "ex11_out";
+
+void fill_vector(const Petsc::DA& da, Petsc::Vec& vec, Petsc::Real time);
+
+int main(int argc, char** argv) {
+  using namespace Petsc;
+
+  try {
+    Context::Instance(&argc, &argv);
+
+#ifndef PETSC_HAVE_MPIIO
+    Printf(PETSC_COMM_WORLD, "Warning: Executing requires a working MPI-2 implementation\n");
+#else
+
+    Int steps = 20;
+    Real dt = 0.1;
+    Int3 globalSize = {32, 32, 32};
+    auto da = Petsc::DA::Create3d(DM_BOUNDARY_NONE, DMDA_STENCIL_STAR, globalSize, PETSC_DECIDE, 1, 1, NULL);
+    da.SetFromOptions();
+    da.SetUp();
+
+    auto x = da.CreateGlobalVector();
+
+    // All steps go into one file, instead of a file per dump. The second half is appended as a
+    // restarted run would do.
+    for (Bool append : {PETSC_FALSE, PETSC_TRUE}) {
+      Petsc::TimeSeriesWriter writer(PETSC_COMM_WORLD, output_filename, append);
+      Int first = append ? steps / 2 : 0;
+      Int last = append ? steps : steps / 2;
+      for (Int step = first; step < last; ++step) {
+        fill_vector(da, x, step * dt);
+
+        writer.BeginStep(step, step * dt);
+        writer.WriteField("u", da, x);
+        writer.EndStep();
+
+        if (step % 5 == 4) {
+          writer.Commit();
+        }
+      }
+    }
+
+    // Any step is read directly through the footer index
+    Petsc::TimeSeriesReader reader(PETSC_COMM_WORLD, output_filename);
+    Int n = reader.FindStep(steps / 2);
+
+    auto y = da.CreateGlobalVector();
+    reader.ReadField(n, "u", da, y);
+    fill_vector(da, x, reader.GetTime(n));
+
+    Real diff = Petsc::Vec::WAXPY(-1.0, x, y).Norm(NORM_INFINITY);
+    Printf(PETSC_COMM_WORLD, "Time series of %" PetscInt_FMT " steps:\n", reader.GetNumSteps());
+    Printf(PETSC_COMM_WORLD, "  step %" PetscInt_FMT " at time %1.2f, max(|a-b|) = %1.3e\n",
+      reader.GetStep(n), (double)reader.GetTime(n), (double)diff);
+#endif
+  }
+  catch (const Petsc::Exception& e) {
+    Printf(PETSC_COMM_WORLD, e.what());
+    PetscCallMPI(MPI_Abort(PETSC_COMM_WORLD, (MPIInt)e.code()));
+  }
+  catch (...) {
+    Printf(PETSC_COMM_WORLD, "Unkown exception captured!");
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+void fill_vector(const Petsc::DA& da, Petsc::Vec& vec, Petsc::Real time)  {
+  using namespace Petsc;
+
+  auto globalSize = da.GetSizes();
+
+  auto array = da.GetView<3>(vec);
+  da.ForEachPoint([&](Int k, Int j, Int i) {
+    array(k, j, i) = std::sin((Real)i / globalSize.x + time) + (Real)(j + k) / globalSize.y;
+  });
+}
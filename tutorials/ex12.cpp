@@ -0,0 +1,79 @@
+#include <context.h>
+#include <exception.h>
+#include <dmda.h>
+
+void fill_vector(const Petsc::DA& da, Petsc::Vec& vec);
+void view_ranges(const Petsc::DA& da, const char* name);
+
+int main(int argc, char** argv) {
+  using namespace Petsc;
+
+  try {
+    Context::Instance(&argc, &argv);
+
+    Int3 globalSize = {48, 32, 32};
+    auto da = Petsc::DA::Create3d(DM_BOUNDARY_NONE, DMDA_STENCIL_STAR, globalSize, PETSC_DECIDE, 1, 1, NULL);
+    da.SetFromOptions();
+    da.SetUp();
+
+    auto x = da.CreateGlobalVector();
+    fill_vector(da, x);
+
+    // The first quarter of the grid along x is ten times as expensive, so the balanced
+    // ranges differ from the even ones whenever there is more than one process along x
+    auto cost = da.CreateFieldVector();
+    {
+      auto array = da.GetView<3>(cost);
+      da.ForEachPoint([&](Int k, Int j, Int i) {
+        array(k, j, i) = i < globalSize.x / 4 ? 10.0 : 1.0;
+      });
+    }
+
+    auto balanced = da.Balance(cost);
+    view_ranges(da, "even");
+    view_ranges(balanced, "balanced");
+
+    // Values depend on the global position only, so they are the same after the move
+    auto y = da.Redistribute(x, balanced);
+    auto expected = balanced.CreateGlobalVector();
+    fill_vector(balanced, expected);
+
+    Real diff = Petsc::Vec::WAXPY(-1.0, expected, y).Norm(NORM_INFINITY);
+    Printf(PETSC_COMM_WORLD, "Redistributed vector, max(|a-b|) = %1.3e\n", (double)diff);
+  }
+  catch (const Petsc::Exception& e) {
+    Printf(PETSC_COMM_WORLD, e.what());
+    PetscCallMPI(MPI_Abort(PETSC_COMM_WORLD, (MPIInt)e.code()));
+  }
+  catch (...) {
+    Printf(PETSC_COMM_WORLD, "Unkown exception captured!");
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+void fill_vector(const Petsc::DA& da, Petsc::Vec& vec)  {
+  using namespace Petsc;
+
+  auto globalSize = da.GetSizes();
+
+  auto array = da.GetView<3>(vec);
+  da.ForEachPoint([&](Int k, Int j, Int i) {
+    array(k, j, i) = i + globalSize.x * (j + globalSize.y * k);
+  });
+}
+
+
+void view_ranges(const Petsc::DA& da, const char* name) {
+  using namespace Petsc;
+
+  auto procs = da.GetNumProcs();
+  auto ranges = da.GetOwnershipRanges();
+
+  Printf(PETSC_COMM_WORLD, "Ownership ranges along x, %s:", name);
+  for (Int p = 0; p < procs.x; ++p) {
+    Printf(PETSC_COMM_WORLD, " %" PetscInt_FMT, ranges.x[p]);
+  }
+  Printf(PETSC_COMM_WORLD, "\n");
+}
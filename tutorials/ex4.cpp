@@ -10,6 +10,9 @@ void compare_vectors(const Petsc::Vec& lhs, const Petsc::Vec& rhs);
 
 void load_backup(Petsc::Vec& vec);
 void save_backup(const Petsc::Vec& vec);
+#ifdef PETSC_HAVE_MPIIO
+void load_region(const Petsc::DA& da, const Petsc::Vec& vec);
+#endif
 
 
 int main(int argc, char** argv) {
@@ -37,6 +40,10 @@ int main(int argc, char** argv) {
     load_backup(y);
 
     compare_vectors(x, y);
+
+#ifdef PETSC_HAVE_MPIIO
+    load_region(da, x);
+#endif
   }
   catch (const Petsc::Exception& e) {
     Printf(PETSC_COMM_WORLD, e.what());
@@ -57,13 +64,14 @@ void fill_vector(Petsc::DA& da, Petsc::Vec& vec)  {
   auto globalSize = da.GetSizes();
   auto dof = da.GetDof();
 
-  // Note the index ordering: array[z][y][x][DOF], and that indexes are global
-  auto array = da.GetArray<Scalar****>(vec, DOF);
+  // Note the index ordering: array(z, y, x, DOF), and that indexes are global.
+  // The view is a flat array with strides, so the innermost loop is unit-stride.
+  auto array = da.GetView<3, dynamicExtent>(vec);
   for (Int k = localStart.z; k < localStart.z + localSize.z; ++k) {
   for (Int j = localStart.y; j < localStart.y + localSize.y; ++j) {
   for (Int i = localStart.x; i < localStart.x + localSize.x; ++i) {
     for (Int l = 0; l < dof; l++) {
-      array[k][j][i][l] = l + dof * (i + globalSize.x * (j + globalSize.y * k));
+      array(k, j, i, l) = l + dof * (i + globalSize.x * (j + globalSize.y * k));
     }
   }}}
 }
@@ -117,3 +125,40 @@ void compare_vectors(const Petsc::Vec& lhs, const Petsc::Vec& rhs) {
     Printf(PETSC_COMM_WORLD, "  min(|a-b|) < 1.0e-10\n");
   }
 }
+
+#ifdef PETSC_HAVE_MPIIO
+void load_region(const Petsc::DA& da, const Petsc::Vec& vec) {
+  using namespace Petsc;
+
+  MPI_Comm comm;
+  PetscCallThrow(PetscObjectGetComm(da, &comm));
+
+  auto viewer = Petsc::Binary::Open(comm, output_filename, FILE_MODE_READ);
+  viewer.SetUseMPIIO(PETSC_TRUE);
+  viewer.SetSkipInfo(PETSC_TRUE);
+  viewer.SetSkipHeader(PETSC_TRUE);
+
+  // The whole box read into a DA of its own is split as the original one, on any number of processes
+  auto box = da.LoadRegion(viewer, {0, 0, 0}, da.GetSizes());
+  Printf(PETSC_COMM_WORLD, "\nRegion of the whole box, max(|a-b|) = %1.3e\n",
+    (double)Petsc::Vec::WAXPY(-1.0, vec, box).Norm(NORM_INFINITY));
+
+  // Each read moves the offset past the vector, so go back to the beginning of the file
+  viewer.AddMPIIOOffset(-viewer.GetMPIIOOffset());
+
+  // Only the plane z = 1 of the box is read from the file. The region is too small to be split
+  // over a DA of its own on any number of processes, so each of them reads all of it.
+  Int3 lo = {0, 1, 1}, hi = {2, 3, 2};
+  auto region = da.LoadRegionLocal(viewer, lo, hi);
+
+  Printf(PETSC_COMM_WORLD, "\nRegion [0, 2) x [1, 3) x [1, 2):\n");
+  Int dof = da.GetDof();
+  Int width = (hi.x - lo.x) * dof;
+  for (Int row = 0; row < (Int)region.size() / width; ++row) {
+    for (Int e = 0; e < width; ++e) {
+      Printf(PETSC_COMM_WORLD, " %g", (double)PetscRealPart(region[row * width + e]));
+    }
+    Printf(PETSC_COMM_WORLD, "\n");
+  }
+}
+#endif
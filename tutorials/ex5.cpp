@@ -67,12 +67,10 @@ void setup_index_set(const Petsc::Vec& vec, Petsc::IS& is) {
   {
     Printf(PETSC_COMM_SELF, "\nPrinting indices directly, process [%]" PetscInt_FMT "\n", rank);
 
-    Int isLocalSize = is.GetLocalSize();
-    const Int *indices = is.GetIndices();
-    for (Int i = 0; i < isLocalSize; i++) {
-      Printf(PETSC_COMM_SELF, "%" PetscInt_FMT "\n", indices[i]);
+    auto indices = is.GetIndices();
+    for (Int index : indices.span()) {
+      Printf(PETSC_COMM_SELF, "%" PetscInt_FMT "\n", index);
     }
-    is.RestoreIndices(&indices);
   }
 }
 
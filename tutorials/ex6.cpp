@@ -1,15 +1,11 @@
-#include <vector>
-
 #include <context.h>
 #include <exception.h>
 #include <binary.h>
 #include <dmda.h>
-#include <is.h>
 
 constexpr const char* output_filename = "ex6_out";
 
-void fill_vector(Petsc::Vec& vec);
-void setup_index_set(const Petsc::DA& da, Petsc::IS& is);
+void fill_vector(const Petsc::DA& da, Petsc::Vec& vec);
 void save_component(const Petsc::Vec& vec);
 void load_component(Petsc::Vec& vec);
 void compare_components(const Petsc::Vec& lhs, const Petsc::Vec& rhs);
@@ -26,18 +22,19 @@ int main(int argc, char** argv) {
     da.SetUp();
 
     auto x = da.CreateGlobalVector();
-    fill_vector(x);
+    fill_vector(da, x);
 
-    auto is = Petsc::IS::Create(PETSC_COMM_WORLD);
-    setup_index_set(da, is);
+    // Component 1 on the plane y = globalSize.y / 2, the slice is in natural (k, i) ordering
+    Int comp = 1;
+    DA::Box plane = {{0, globalSize.y / 2, 0}, {globalSize.x, 1, globalSize.z}};
 
-    auto subVec = x.GetSubVector(is);
-    save_component(subVec);
+    auto slice = da.GetNaturalSlice(x, plane, comp);
+    save_component(slice);
 
-    auto x_comp = Petsc::Vec::FromGlobals(is.GetSize());
+    auto x_comp = Petsc::Vec::FromGlobals(slice.GetSize());
     load_component(x_comp);
 
-    compare_components(subVec, x_comp);
+    compare_components(slice, x_comp);
   }
   catch (const Petsc::Exception& e) {
     Printf(PETSC_COMM_WORLD, e.what());
@@ -51,36 +48,19 @@ int main(int argc, char** argv) {
 }
 
 
-void fill_vector(Petsc::Vec& vec)  {
-  using namespace Petsc;
-
-  auto [rstart, _] = vec.GetOwnershipRange();
-  auto arr = vec.GetArray();
-  for (auto it = arr.begin(); it != arr.end(); ++it) {
-    it.value() = rstart + it.index();
-  }
-  // vec.View(PETSC_VIEWER_STDOUT_WORLD);
-}
-
-void setup_index_set(const Petsc::DA& da, Petsc::IS& is) {
+void fill_vector(const Petsc::DA& da, Petsc::Vec& vec)  {
   using namespace Petsc;
 
-  auto [localStart, localSize] = da.GetCorners();
   auto globalSize = da.GetSizes();
   auto dof = da.GetDof();
 
-  Int comp = 1;
-  Int j = globalSize.y / 2;
-
-  std::vector<Int> indices;
-  for (Int k = localStart.z; k < localStart.z + localSize.z; ++k) {
-  // for (Int j = localStart.y; j < localStart.y + localSize.y; ++j) {
-  for (Int i = localStart.x; i < localStart.x + localSize.x; ++i) {
-    indices.emplace_back(comp + dof * (i + globalSize.x * (j + globalSize.y * k)));
-  }}
-
-  is.SetType(ISGENERAL);
-  is.GeneralSetIndices(indices.size(), indices.data(), PETSC_COPY_VALUES);
+  // Values are the natural indices, so the saved slice can be checked by hand
+  auto array = da.GetView<3, dynamicExtent>(vec);
+  da.ForEachPoint([&](Int k, Int j, Int i) {
+    for (Int l = 0; l < dof; l++) {
+      array(k, j, i, l) = l + dof * (i + globalSize.x * (j + globalSize.y * k));
+    }
+  });
 }
 
 void save_component(const Petsc::Vec& vec) {
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <vector>
+
+#include <context.h>
+#include <exception.h>
+#include <vec.h>
+#include <mat.h>
+#include <ksp.h>
+#include <ensemble.h>
+
+Petsc::Real solve_member(MPI_Comm comm, Petsc::Int member, Petsc::Int globalSize);
+
+int main(int argc, char** argv) {
+  using namespace Petsc;
+
+  try {
+    Context::Instance(&argc, &argv);
+
+    MPIInt size;
+    MPI_Comm_size(PETSC_COMM_WORLD, &size);
+
+    Int members = 64;
+    Int globalSize = 200;
+
+    // Each group of processes solves its own share of independent systems
+    Ensemble ensemble(PETSC_COMM_WORLD, std::min<Int>(size, members));
+
+    std::vector<Scalar> errors;
+    ensemble.Run(members, [&](Int member, MPI_Comm comm) {
+      errors.emplace_back(solve_member(comm, member, globalSize));
+    });
+
+    auto all = ensemble.Gather(members, 1, errors);
+    for (Int member = 0; member < (Int)all.size(); ++member) {
+      Printf(PETSC_COMM_WORLD, "Member %" PetscInt_FMT ", norm of error: %g\n", member, (double)PetscRealPart(all[member]));
+    }
+  }
+  catch (const Petsc::Exception& e) {
+    Printf(PETSC_COMM_WORLD, e.what());
+    PetscCallMPI(MPI_Abort(PETSC_COMM_WORLD, (MPIInt)e.code()));
+  }
+  catch (...) {
+    Printf(PETSC_COMM_WORLD, "Unkown exception captured!");
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+Petsc::Real solve_member(MPI_Comm comm, Petsc::Int member, Petsc::Int globalSize) {
+  using namespace Petsc;
+
+  auto x = Petsc::Vec::FromGlobals(comm, globalSize, "Approximate solution");
+  auto b = x.Duplicate();
+  auto u = x.Duplicate();
+
+  auto [localStart, localEnd] = x.GetOwnershipRange();
+  auto localSize = x.GetLocalSize();
+
+  // Shifted laplace operator, the shift is the ensemble parameter
+  Petsc::Mat A(comm, localSize, localSize, globalSize, globalSize, "Linear system");
+  Scalar shift = 0.01 * member;
+
+  for (Int i = localStart; i < localEnd; i++) {
+    Int col[3] = {i - 1, i, i + 1};
+    Scalar value[3] = {-1.0, 2.0 + shift, -1.0};
+
+    if (i == 0) {
+      A.SetValues(1, &i, 2, col + 1, value + 1, INSERT_VALUES);
+    }
+    else if (i == globalSize - 1) {
+      A.SetValues(1, &i, 2, col, value, INSERT_VALUES);
+    }
+    else {
+      A.SetValues(1, &i, 3, col, value, INSERT_VALUES);
+    }
+  }
+  A.AssemblyBegin(MAT_FINAL_ASSEMBLY);
+  A.AssemblyEnd(MAT_FINAL_ASSEMBLY);
+
+  u.Set(1.0);
+  A.Mult(u, b);
+
+  auto ksp = Petsc::KSP::FromOptions(comm, "Member solver");
+  ksp.SetOperators(A, A);
+  ksp.Solve(b, x);
+
+  return x.AXPY(-1.0, u).Norm(NORM_2);
+}
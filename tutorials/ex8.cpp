@@ -0,0 +1,79 @@
+#include <context.h>
+#include <exception.h>
+#include <dmda.h>
+#include <halo.h>
+
+void fill_vector(const Petsc::DA& da, Petsc::Vec& vec);
+
+int main(int argc, char** argv) {
+  using namespace Petsc;
+
+  try {
+    Context::Instance(&argc, &argv);
+
+    Int dof = 2;
+    Int repeats = 100;
+    Int3 globalSize = {64, 64, 64};
+    auto da = Petsc::DA::Create3d(DM_BOUNDARY_PERIODIC, DMDA_STENCIL_BOX, globalSize, PETSC_DECIDE, dof, 1, NULL);
+    da.SetFromOptions();
+    da.SetUp();
+
+    auto x = da.CreateGlobalVector();
+    fill_vector(da, x);
+
+    auto reference = da.CreateLocalVector();
+    auto local = da.CreateLocalVector();
+
+    // The plan is built once, repeated exchanges only start the persistent requests
+    Petsc::HaloExchange halo(da);
+
+    MPI_Barrier(PETSC_COMM_WORLD);
+    double start = MPI_Wtime();
+    for (Int r = 0; r < repeats; ++r) {
+      da.GlobalToLocal(x, INSERT_VALUES, reference);
+    }
+    double scatterTime = (MPI_Wtime() - start) / repeats;
+
+    MPI_Barrier(PETSC_COMM_WORLD);
+    start = MPI_Wtime();
+    for (Int r = 0; r < repeats; ++r) {
+      halo.GlobalToLocal(x, local);
+    }
+    double haloTime = (MPI_Wtime() - start) / repeats;
+
+    Real diff = Petsc::Vec::WAXPY(-1.0, reference, local).Norm(NORM_INFINITY);
+    PetscCallMPIThrow(MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPIU_REAL, MPIU_MAX, PETSC_COMM_WORLD));
+
+    PetscCallMPIThrow(MPI_Allreduce(MPI_IN_PLACE, &scatterTime, 1, MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD));
+    PetscCallMPIThrow(MPI_Allreduce(MPI_IN_PLACE, &haloTime, 1, MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD));
+
+    Printf(PETSC_COMM_WORLD, "Ghost update of %" PetscInt_FMT " neighbors, averaged over %" PetscInt_FMT " repeats:\n", halo.GetNumNeighbors(), repeats);
+    Printf(PETSC_COMM_WORLD, "  DMGlobalToLocal: %1.3e s\n", scatterTime);
+    Printf(PETSC_COMM_WORLD, "  HaloExchange:    %1.3e s\n", haloTime);
+    Printf(PETSC_COMM_WORLD, "  max(|a-b|) = %1.3e\n", (double)diff);
+  }
+  catch (const Petsc::Exception& e) {
+    Printf(PETSC_COMM_WORLD, e.what());
+    PetscCallMPI(MPI_Abort(PETSC_COMM_WORLD, (MPIInt)e.code()));
+  }
+  catch (...) {
+    Printf(PETSC_COMM_WORLD, "Unkown exception captured!");
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+void fill_vector(const Petsc::DA& da, Petsc::Vec& vec)  {
+  using namespace Petsc;
+
+  auto globalSize = da.GetSizes();
+  auto dof = da.GetDof();
+
+  auto array = da.GetView<3, dynamicExtent>(vec);
+  da.ForEachPoint([&](Int k, Int j, Int i) {
+    for (Int l = 0; l < dof; l++) {
+      array(k, j, i, l) = l + dof * (i + globalSize.x * (j + globalSize.y * k));
+    }
+  });
+}
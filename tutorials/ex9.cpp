@@ -0,0 +1,92 @@
+#include <cmath>
+
+#include <context.h>
+#include <exception.h>
+#include <binary.h>
+#include <dmda.h>
+
+constexpr const char* output_filename = "ex9_out";
+
+void fill_vector(const Petsc::DA& da, Petsc::Vec& vec);
+
+int main(int argc, char** argv) {
+  using namespace Petsc;
+
+  try {
+    Context::Instance(&argc, &argv);
+
+#ifndef PETSC_HAVE_MPIIO
+    Printf(PETSC_COMM_WORLD, "Warning: Executing requires a working MPI-2 implementation\n");
+#else
+    Int3 globalSize = {64, 64, 64};
+    auto da = Petsc::DA::Create3d(DM_BOUNDARY_NONE, DMDA_STENCIL_STAR, globalSize, PETSC_DECIDE, 1, 1, NULL);
+    da.SetFromOptions();
+    da.SetUp();
+
+    auto x = da.CreateGlobalVector();
+    fill_vector(da, x);
+
+    // The same field is written lossless and with an error bound relative to its range
+    Real bound = 1.0e-4;
+    MPI_Offset losslessBytes, quantizedBytes;
+    Real achieved;
+    {
+      auto viewer = Petsc::Binary::Open(PETSC_COMM_WORLD, output_filename, FILE_MODE_WRITE);
+      viewer.SetUseMPIIO(PETSC_TRUE);
+      viewer.SetSkipHeader(PETSC_TRUE);
+
+      MPI_Offset base = viewer.GetMPIIOOffset();
+      viewer.WriteCompressed(x);
+      losslessBytes = viewer.GetMPIIOOffset() - base;
+
+      achieved = viewer.WriteQuantized(x, bound, PETSC_TRUE);
+      quantizedBytes = viewer.GetMPIIOOffset() - base - losslessBytes;
+    }
+
+    auto lossless = da.CreateGlobalVector();
+    auto quantized = da.CreateGlobalVector();
+    {
+      auto viewer = Petsc::Binary::Open(PETSC_COMM_WORLD, output_filename, FILE_MODE_READ);
+      viewer.SetUseMPIIO(PETSC_TRUE);
+      viewer.SetSkipHeader(PETSC_TRUE);
+
+      viewer.ReadCompressed(lossless);
+      viewer.ReadCompressed(quantized);
+    }
+
+    Real range = x.Max().second - x.Min().second;
+    Real rawBytes = (Real)x.GetSize() * sizeof(Scalar);
+
+    Printf(PETSC_COMM_WORLD, "Output of %" PetscInt_FMT " values:\n", x.GetSize());
+    Printf(PETSC_COMM_WORLD, "  lossless:  %1.2fx reduction, max(|a-b|) = %1.3e\n",
+      (double)(rawBytes / losslessBytes), (double)Binary::GetMaxError(x, lossless));
+    Printf(PETSC_COMM_WORLD, "  quantized: %1.2fx reduction, max(|a-b|) = %1.3e, reported %1.3e, bound %1.3e\n",
+      (double)(rawBytes / quantizedBytes), (double)Binary::GetMaxError(x, quantized), (double)achieved, (double)(bound * range));
+#endif
+  }
+  catch (const Petsc::Exception& e) {
+    Printf(PETSC_COMM_WORLD, e.what());
+    PetscCallMPI(MPI_Abort(PETSC_COMM_WORLD, (MPIInt)e.code()));
+  }
+  catch (...) {
+    Printf(PETSC_COMM_WORLD, "Unkown exception captured!");
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+void fill_vector(const Petsc::DA& da, Petsc::Vec& vec)  {
+  using namespace Petsc;
+
+  auto globalSize = da.GetSizes();
+
+  // Smooth field, as typical diagnostics are, that compresses poorly without loss
+  auto array = da.GetView<3>(vec);
+  da.ForEachPoint([&](Int k, Int j, Int i) {
+    Real x = (Real)i / globalSize.x;
+    Real y = (Real)j / globalSize.y;
+    Real z = (Real)k / globalSize.z;
+    array(k, j, i) = std::sin(2 * M_PI * x) * std::cos(2 * M_PI * y) + z * z;
+  });
+}